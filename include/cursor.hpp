@@ -0,0 +1,26 @@
+#ifndef GIC_CURSOR_HPP
+#define GIC_CURSOR_HPP
+
+#include <cstddef>
+
+namespace genex {
+
+// Position of an incremental pass over a genex container, as advanced by its
+// advance() member function. It is the index of the next slot to look at, so
+// unlike an iterator it stays usable whatever happens to the container
+// between two calls.
+//
+// Elements emplaced in a freed slot the cursor already passed are only seen
+// by the next pass; elements appended at the back are seen by this one.
+struct gic_cursor {
+    std::size_t position = 0;
+
+    // starts a new pass
+    void reset() noexcept {
+        position = 0;
+    }
+};
+
+} // end namespace genex
+
+#endif // GIC_CURSOR_HPP
@@ -0,0 +1,58 @@
+#ifndef GIC_DELTA_HPP
+#define GIC_DELTA_HPP
+
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace genex {
+
+// What changed between two states of a container, to bring a copy of the
+// first state, e.g. on another machine, to the second one:
+//  - destroyed: keys of the elements that were removed,
+//  - created: keys and values of the elements that were emplaced,
+//  - modified: keys and new values of the elements whose value changed.
+// A slot whose element was replaced by another one shows up both as destroyed
+// and as created, since the generation of its key changed.
+template<typename T, class Key>
+struct gic_delta {
+    using key_type = Key;
+    using generation_type = typename Key::generation_type;
+
+    std::vector<Key> destroyed;
+    std::vector<std::pair<Key, T>> created;
+    std::vector<std::pair<Key, T>> modified;
+
+    // the bookkeeping of the second state, for the copy to match it
+    std::size_t slot_count = 0;
+    generation_type appended_generation{};
+
+    [[nodiscard]] bool empty() const noexcept {
+        return destroyed.empty() && created.empty() && modified.empty();
+    }
+};
+
+// Whether an element was modified, by default: trivially copyable objects are
+// compared byte per byte, which needs no operator== and only finds the
+// difference of padding bytes when the objects were not copied from each
+// other. Other objects are compared with operator==.
+struct bitwise_or_equal {
+    template<typename T>
+    bool operator()(T const& a, T const& b) const {
+        if constexpr (std::is_trivially_copyable_v<T>) {
+            return std::memcmp(std::addressof(a),
+                               std::addressof(b),
+                               sizeof(T)) == 0;
+        }
+        else {
+            return a == b;
+        }
+    }
+};
+
+} // end namespace genex
+
+#endif // GIC_DELTA_HPP
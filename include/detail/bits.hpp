@@ -0,0 +1,44 @@
+#ifndef GENEX_BITS_HPP
+#define GENEX_BITS_HPP
+
+#include <bitset>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+namespace genex::detail {
+
+using bit_word = std::uint64_t;
+
+constexpr std::size_t bits_per_word = std::numeric_limits<bit_word>::digits;
+
+inline std::size_t count_set_bits(bit_word word) noexcept {
+    return std::bitset<bits_per_word>(word).count();
+}
+
+// word must not be zero.
+inline std::size_t lowest_set_bit(bit_word word) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+    return static_cast<std::size_t>(__builtin_ctzll(word));
+#else
+    std::size_t idx = 0;
+    while((word & 1) == 0) {
+        word >>= 1;
+        ++idx;
+    }
+    return idx;
+#endif
+}
+
+// Calls f with the position of each set bit of word, lowest first.
+template<typename F>
+void for_each_set_bit(bit_word word, F&& f) {
+    while(word != 0) {
+        f(lowest_set_bit(word));
+        word &= word - 1;
+    }
+}
+
+} // end namespace genex::detail
+
+#endif // GENEX_BITS_HPP
@@ -0,0 +1,171 @@
+#ifndef GENEX_FREE_LISTS_HPP
+#define GENEX_FREE_LISTS_HPP
+
+#include <cstddef>
+#include <algorithm>
+#include <utility>
+#include <type_traits>
+
+#include "manually_destructed.hpp"
+#include "element_validity_embedded_in_generation.hpp"
+#include "memory_usage.hpp"
+
+namespace genex {
+
+// Given as IndexContainer of split_gic, makes the free slots hold the indexes
+// of the next free slots instead of storing them in a container, like gic_fit
+// does. Slots are then at least as big as an index.
+struct intrusive_free_list {};
+
+namespace detail {
+
+// The indexes of the free slots of split_gic, in a container used as a stack.
+template<class IndexContainer, typename Index>
+class free_index_stack {
+public:
+    template<typename T>
+    using wrapped_type = manually_destructed<T>;
+
+    bool empty() const noexcept {
+        return indexes.empty();
+    }
+
+    template<class Objects>
+    Index pop(Objects&) {
+        auto idx = indexes.back();
+        indexes.pop_back();
+        return idx;
+    }
+
+    template<class Objects>
+    void push(Index const& idx, Objects&) {
+        indexes.push_back(idx);
+    }
+
+    // Forgets the indexes of the slots that were dropped from the back.
+    template<class Generations, class Objects>
+    void trim(std::size_t size, Generations const&, Objects&) {
+        indexes.erase(
+            std::remove_if(indexes.begin(),
+                           indexes.end(),
+                           [size](auto const& idx) { return idx >= size; }),
+            indexes.end());
+    }
+
+    // Nothing to do after the living objects were moved or copied to other
+    // slots.
+    template<class Generations, class Objects>
+    void relink(Generations const&, Objects const&, Objects&) {}
+
+    // Forgets every index and pushes those of the free slots, the lowest on
+    // top.
+    template<class Generations, class Objects>
+    void rebuild(Generations const& gens, Objects&) {
+        indexes.clear();
+        for(auto idx = gens.size(); idx != 0; --idx) {
+            if(!is_valid(gens[idx - 1])) {
+                indexes.push_back(static_cast<Index>(idx - 1));
+            }
+        }
+    }
+
+    void shrink_to_fit() {
+        indexes.shrink_to_fit();
+    }
+
+    container_memory memory() const noexcept {
+        return memory_of(indexes);
+    }
+
+    void swap(free_index_stack& other) noexcept {
+        using std::swap;
+        swap(indexes, other.indexes);
+    }
+
+private:
+    IndexContainer indexes;
+};
+
+// A singly-linked list threaded through the destroyed space of the free slots.
+template<typename Index>
+class intrusive_free_index_list {
+public:
+    template<typename T>
+    using wrapped_type = manually_destructed<T, Index>;
+
+    bool empty() const noexcept {
+        return count == 0;
+    }
+
+    template<class Objects>
+    Index pop(Objects& objects) {
+        auto idx = head;
+        head = objects[idx].destroyed_space();
+        --count;
+        return idx;
+    }
+
+    template<class Objects>
+    void push(Index const& idx, Objects& objects) {
+        objects[idx].destroyed_space() = head;
+        head = idx;
+        ++count;
+    }
+
+    template<class Generations, class Objects>
+    void trim(std::size_t, Generations const& gens, Objects& objects) {
+        rebuild(gens, objects);
+    }
+
+    // Copies the links of the free slots of 'from' into 'to', since only the
+    // living objects were moved or copied there. The list keeps its order, so
+    // that a copy reuses the free slots in the same order as the original.
+    template<class Generations, class Objects>
+    void relink(Generations const& gens, Objects const& from, Objects& to) {
+        for(std::size_t idx = 0; idx < gens.size(); ++idx) {
+            if(!is_valid(gens[idx])) {
+                to[idx].destroyed_space() = from[idx].destroyed_space();
+            }
+        }
+    }
+
+    // Links the free slots anew, the lowest first.
+    template<class Generations, class Objects>
+    void rebuild(Generations const& gens, Objects& objects) {
+        head = Index{};
+        count = 0;
+        for(auto idx = gens.size(); idx != 0; --idx) {
+            if(!is_valid(gens[idx - 1])) {
+                push(static_cast<Index>(idx - 1), objects);
+            }
+        }
+    }
+
+    void shrink_to_fit() {}
+
+    container_memory memory() const noexcept {
+        return {};
+    }
+
+    void swap(intrusive_free_index_list& other) noexcept {
+        using std::swap;
+        swap(head, other.head);
+        swap(count, other.count);
+    }
+
+private:
+    Index head{};
+    std::size_t count = 0;
+};
+
+template<class IndexContainer, typename Index>
+using free_list_for = std::conditional_t<
+    std::is_same_v<IndexContainer, intrusive_free_list>,
+    intrusive_free_index_list<Index>,
+    free_index_stack<IndexContainer, Index>>;
+
+} // end namespace detail
+
+} // end namespace genex
+
+#endif // GENEX_FREE_LISTS_HPP
@@ -9,19 +9,19 @@ struct crtp_base {
 protected:
     using derived_type = Derived;
 
-    Derived& as_derived() & {
+    constexpr Derived& as_derived() & {
         return static_cast<Derived&>(*this);
     }
 
-    Derived const & as_derived() const & {
+    constexpr Derived const & as_derived() const & {
         return static_cast<Derived const &>(*this);
     }
 
-    Derived&& as_derived() && {
+    constexpr Derived&& as_derived() && {
         return static_cast<Derived&&>(*this);
     }
 
-    Derived const && as_derived() const && {
+    constexpr Derived const && as_derived() const && {
         return static_cast<Derived const &&>(*this);
     }
 };
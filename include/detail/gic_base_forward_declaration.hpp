@@ -5,7 +5,8 @@ namespace genex {
 
 template<typename Derived,
          typename T,
-         typename Key>
+         typename Key,
+         typename Statistics>
 class gic_base;
 
 } // end genex
@@ -1,6 +1,7 @@
 #ifndef GIC_CORE_ACCESS_HPP
 #define GIC_CORE_ACCESS_HPP
 
+#include <cstddef>
 #include <utility>
 #include "perfect_backward.hpp"
 #include "gic_base_forward_declaration.hpp"
@@ -17,18 +18,31 @@ class gic_core_access {
 
     template<typename Derived,
              typename T,
-             typename Key>
+             typename Key,
+             typename Statistics>
     friend class ::genex::gic_base;
 
 
     template<class Derived>
-    static decltype(auto)
+    static constexpr decltype(auto)
     unchecked_get(Derived& gic, typename Derived::index_type const& idx)
     {
         return PERFECT_BACKWARD(Derived::unchecked_get(gic, idx));
     }
 
 
+    template<class Derived>
+    static std::size_t slot_count(Derived const& gic) {
+        return Derived::slot_count(gic);
+    }
+
+    template<class Derived>
+    static decltype(auto)
+    slot_generation(Derived const& gic, std::size_t idx) {
+        return PERFECT_BACKWARD(Derived::slot_generation(gic, idx));
+    }
+
+
     template<typename Derived, typename B, typename E>
     static decltype(auto) make_iterator(Derived& gic,
                                         B&& begin,
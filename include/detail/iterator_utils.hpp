@@ -45,6 +45,19 @@ struct cend_getter {
 constexpr cend_getter cend_getter_v;
 
 
+// Compares equal to any iterator of a genex container that reached the end,
+// which only checks the position of the iterator against its own bound.
+struct end_sentinel_t {};
+
+constexpr end_sentinel_t end_sentinel;
+
 } // end namespace genex::detail
 
+namespace genex {
+
+using detail::end_sentinel_t;
+using detail::end_sentinel;
+
+} // end namespace genex
+
 #endif // ITERATOR_UTILS_HPP
@@ -13,7 +13,7 @@ struct key_placeholder_t {};
 constexpr key_placeholder_t key_placeholder;
 
 template<typename Arg, typename Key>
-decltype(auto) forward_arg_or_key(Arg&& arg, Key key) {
+constexpr decltype(auto) forward_arg_or_key(Arg&& arg, Key key) {
     if constexpr (std::is_same_v<std::remove_reference_t<Arg> const,
                                  key_placeholder_t const>) {
         return key;
@@ -23,6 +23,12 @@ decltype(auto) forward_arg_or_key(Arg&& arg, Key key) {
     }
 }
 
+// Wrappers that translate the keys of their underlying containers cannot hand
+// out the final key while the object is constructed.
+template<typename... Args>
+constexpr bool has_key_placeholder_v =
+    (std::is_same_v<std::decay_t<Args>, key_placeholder_t> || ...);
+
 } // end namespace detail
 
 using detail::key_placeholder;
@@ -0,0 +1,127 @@
+#ifndef GENEX_LIVE_OBJECTS_HPP
+#define GENEX_LIVE_OBJECTS_HPP
+
+#include <cstddef>
+#include <cstring>
+#include <utility>
+#include <type_traits>
+
+#include "element_validity_embedded_in_generation.hpp"
+#include "relocation.hpp"
+
+namespace genex::detail {
+
+// Algorithms over a container of manually_destructed objects whose parallel
+// container of generations tells which slots hold a living object.
+//
+// Such a container is never resized: manually_destructed cannot be moved by
+// the container, since it does not know whether it holds an object. It is
+// created with as many slots as it can hold, which is a no-op for each of
+// them, and replaced by a bigger one with relocate_live_objects. Only its
+// first slots, as many as there are generations, are used.
+
+// Destroys the living objects of the first count slots.
+template<typename GenerationContainer, typename ObjectContainer>
+void destroy_live_objects(GenerationContainer const& gens,
+                          ObjectContainer& objs,
+                          std::size_t count)
+{
+    using value_type = typename ObjectContainer::value_type::value_type;
+    if constexpr (!std::is_trivially_destructible_v<value_type>) {
+        for(std::size_t idx = 0; idx < count; ++idx) {
+            if(is_valid(gens[idx])) {
+                objs[idx].erase();
+            }
+        }
+    }
+}
+
+template<typename GenerationContainer, typename ObjectContainer>
+void destroy_live_objects(GenerationContainer const& gens,
+                          ObjectContainer& objs)
+{
+    destroy_live_objects(gens, objs, gens.size());
+}
+
+// Fills the empty container 'to' with copies of the living objects of 'from',
+// as many slots as there are generations. Free slots are not copied, their
+// storage does not hold any object.
+//
+// Trivially copyable objects are copied all at once instead, free slots
+// included, since this is a single memcpy.
+template<typename GenerationContainer, typename ObjectContainer>
+void copy_live_objects(GenerationContainer const& gens,
+                       ObjectContainer const& from,
+                       ObjectContainer& to)
+{
+    using wrapped_type = typename ObjectContainer::value_type;
+    auto const size = gens.size();
+    ObjectContainer copy(size);
+
+    if constexpr (std::is_trivially_copyable_v<wrapped_type>) {
+        if(size != 0) {
+            std::memcpy(copy.data(), from.data(), size * sizeof(wrapped_type));
+        }
+    }
+    else {
+        std::size_t idx = 0;
+        try {
+            for(; idx < size; ++idx) {
+                if(is_valid(gens[idx])) {
+                    copy[idx].emplace(*from[idx]);
+                }
+            }
+        }
+        catch(...) {
+            destroy_live_objects(gens, copy, idx);
+            throw;
+        }
+    }
+
+    to.swap(copy);
+}
+
+// Moves the objects of 'from' into the container 'to', which holds no object
+// and must have at least as many slots as there are generations. 'from' is
+// left with no object, only slots to discard.
+//
+// Trivially relocatable objects are moved all at once with memcpy. Others are
+// moved one by one, or copied if their move constructor may throw so that
+// 'from' is left untouched by an exception.
+template<typename GenerationContainer, typename ObjectContainer>
+void relocate_live_objects(GenerationContainer const& gens,
+                           ObjectContainer& from,
+                           ObjectContainer& to)
+{
+    using wrapped_type = typename ObjectContainer::value_type;
+    using value_type = typename wrapped_type::value_type;
+    auto const size = gens.size();
+
+    if constexpr (is_trivially_relocatable_v<value_type>) {
+        if(size != 0) {
+            std::memcpy(static_cast<void*>(to.data()),
+                        static_cast<void const*>(from.data()),
+                        size * sizeof(wrapped_type));
+        }
+    }
+    else {
+        std::size_t idx = 0;
+        try {
+            for(; idx < size; ++idx) {
+                if(is_valid(gens[idx])) {
+                    to[idx].emplace(std::move_if_noexcept(*from[idx]));
+                }
+            }
+        }
+        catch(...) {
+            destroy_live_objects(gens, to, idx);
+            throw;
+        }
+
+        destroy_live_objects(gens, from);
+    }
+}
+
+} // end namespace genex::detail
+
+#endif // GENEX_LIVE_OBJECTS_HPP
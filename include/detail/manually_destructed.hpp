@@ -3,10 +3,59 @@
 
 #include <utility>
 #include <memory>
+#include <tuple>
 #include <type_traits>
 
 namespace genex::detail {
 
+// This union is what makes manually_destructed possible: managing its content
+// is done manually, by definition of a union, and this includes the
+// destruction. Therefore, when the instance of the union is destroyed, nothing
+// more than a call to its destructor is done, and since it is empty, nothing
+// happens. Without wrapping the object in this union, even with an empty
+// destructor of manually_destructed, the destructor of the object would have
+// been called.
+//
+// Since the union does not know whether it holds an object, it cannot be
+// copied or moved, except when the object is trivially copyable: copying the
+// bytes is then what the implicit special member functions do. Containers of
+// other manually_destructed objects never grow by themselves, see
+// detail/live_objects.hpp.
+template<typename T,
+         typename WhenDestroyed,
+         bool = std::is_trivially_copyable_v<T>>
+union manually_destructed_storage {
+    T object;
+    WhenDestroyed when_destroyed;
+
+    // does not construct anything
+    manually_destructed_storage() {}
+
+    template<typename... Args>
+    explicit manually_destructed_storage(std::in_place_t, Args&&... args)
+        : object(std::forward<Args>(args)...)
+    {}
+
+    manually_destructed_storage(manually_destructed_storage const&) = delete;
+    manually_destructed_storage& operator=(
+            manually_destructed_storage const&) = delete;
+
+    ~manually_destructed_storage() {}
+};
+
+template<typename T, typename WhenDestroyed>
+union manually_destructed_storage<T, WhenDestroyed, true> {
+    T object;
+    WhenDestroyed when_destroyed;
+
+    manually_destructed_storage() {}
+
+    template<typename... Args>
+    explicit manually_destructed_storage(std::in_place_t, Args&&... args)
+        : object(std::forward<Args>(args)...)
+    {}
+};
+
 
 template<typename T, typename WhenDestroyed = char>
 class manually_destructed {
@@ -14,9 +63,25 @@ public:
 
     using value_type = T;
 
+    // Starts without object, as if erase() had been called. Constructing it
+    // is a no-op, hence creating a container of manually_destructed is cheap.
+    manually_destructed() = default;
+
     template<typename... Args>
+    explicit manually_destructed(std::in_place_t, Args&&... args) :
+        storage(std::in_place, std::forward<Args>(args)...)
+    {}
+
+    // not a copy or move constructor
+    template<typename... Args,
+             typename std::enable_if_t<
+                 !std::is_same_v<
+                     std::tuple<std::remove_cv_t<
+                         std::remove_reference_t<Args>>...>,
+                     std::tuple<manually_destructed>
+                 >, int> = 0>
     explicit manually_destructed(Args&&... args) :
-        storage(std::forward<Args>(args)...)
+        storage(std::in_place, std::forward<Args>(args)...)
     {}
 
     template<typename... Args>
@@ -26,7 +91,9 @@ public:
     }
 
     void erase() {
-        std::destroy_at(&storage.object);
+        if constexpr (!std::is_trivially_destructible_v<T>) {
+            std::destroy_at(&storage.object);
+        }
     }
 
     T * get_pointer() {
@@ -41,36 +108,25 @@ public:
              typename std::enable_if_t<
                  std::is_same_v<
                      std::remove_const_t<std::remove_reference_t<Self>>,
-                     manually_destructed<T>
+                     manually_destructed
                  >, int> = 0>
     friend decltype(auto) operator*(Self&& self) {
         auto& ret = std::forward<Self>(self).storage.object;
         return ret;
     }
 
+    // What the slot holds once its object is destroyed, e.g. the index of the
+    // next free slot.
     WhenDestroyed& destroyed_space() {
         return storage.when_destroyed;
     }
 
+    WhenDestroyed const& destroyed_space() const {
+        return storage.when_destroyed;
+    }
+
 private:
-    // This union is what makes this type possible: managing its content is
-    // done manually, by definition of a union, and this includes the
-    // destruction. Therefore, when the instance of storage_type is destroyed,
-    // nothing more than a call to its destructor is done, and since it is
-    // empty, nothing happens. Without wrapping the object in this union, even
-    // with an empty destructor of manually_destructed, the destructor of the
-    // object would have been called.
-    union storage_type {
-        T object;
-        WhenDestroyed when_destroyed;
-
-        template<typename... Args>
-        explicit storage_type(Args&&... args)
-            : object(std::forward<Args>(args)...)
-        {}
-
-        ~storage_type() {}
-    } storage;
+    manually_destructed_storage<T, WhenDestroyed> storage;
 };
 
 } // end namespace genex::detail
@@ -0,0 +1,92 @@
+#ifndef GENEX_PREFIX_VIEW_HPP
+#define GENEX_PREFIX_VIEW_HPP
+
+#include <cstddef>
+#include <type_traits>
+
+#include <boost/iterator/iterator_facade.hpp>
+
+namespace genex::detail {
+
+// An iterator over contiguous storage. Unlike a raw pointer, it is null when
+// default constructed, which makes it equal to the end of an empty
+// prefix_view, as a vector iterator is equal to the end of an empty vector.
+template<typename T>
+class pointer_iterator : public boost::iterator_facade<
+                             pointer_iterator<T>,
+                             T,
+                             boost::random_access_traversal_tag>
+{
+public:
+    pointer_iterator() = default;
+
+    explicit pointer_iterator(T* p) : ptr(p) {}
+
+    // iterator to const_iterator
+    template<typename U,
+             typename std::enable_if_t<
+                 std::is_convertible_v<U*, T*>, int> = 0>
+    pointer_iterator(pointer_iterator<U> const& other) : ptr(other.ptr) {}
+
+private:
+    friend class boost::iterator_core_access;
+    template<typename> friend class pointer_iterator;
+
+    T& dereference() const {
+        return *ptr;
+    }
+
+    template<typename U>
+    bool equal(pointer_iterator<U> const& other) const {
+        return ptr == other.ptr;
+    }
+
+    void increment() {
+        ++ptr;
+    }
+
+    void decrement() {
+        --ptr;
+    }
+
+    void advance(std::ptrdiff_t n) {
+        ptr += n;
+    }
+
+    template<typename U>
+    std::ptrdiff_t distance_to(pointer_iterator<U> const& other) const {
+        return other.ptr - ptr;
+    }
+
+    T* ptr = nullptr;
+};
+
+// The first 'size' elements of an array, seen as a container to iterate over.
+template<typename T>
+struct prefix_view {
+    T* data;
+    std::size_t size;
+
+    pointer_iterator<T> begin() const {
+        return pointer_iterator<T>{size == 0 ? nullptr : data};
+    }
+
+    pointer_iterator<T> end() const {
+        return pointer_iterator<T>{size == 0 ? nullptr : data + size};
+    }
+
+    pointer_iterator<T const> cbegin() const {
+        return begin();
+    }
+
+    pointer_iterator<T const> cend() const {
+        return end();
+    }
+};
+
+template<typename T>
+prefix_view(T*, std::size_t) -> prefix_view<T>;
+
+} // end namespace genex::detail
+
+#endif // GENEX_PREFIX_VIEW_HPP
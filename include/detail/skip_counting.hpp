@@ -0,0 +1,39 @@
+#ifndef GENEX_SKIP_COUNTING_HPP
+#define GENEX_SKIP_COUNTING_HPP
+
+namespace genex::detail {
+
+// Base class of the iterators, reporting the free slots they step over to the
+// statistics policy of the container.
+// When the statistics are disabled, it is empty and does nothing.
+template<typename Statistics, bool Enabled = Statistics::enabled>
+class skip_counter {
+public:
+    skip_counter() = default;
+    explicit skip_counter(Statistics const*) {}
+
+protected:
+    void count_skip() const noexcept {}
+};
+
+template<typename Statistics>
+class skip_counter<Statistics, true> {
+public:
+    skip_counter() = default;
+    explicit skip_counter(Statistics const* s) : statistics(s) {}
+
+protected:
+    void count_skip() const noexcept {
+        if(statistics != nullptr) {
+            statistics->on_iteration_skip();
+        }
+    }
+
+private:
+    // null for default-constructed iterators
+    Statistics const* statistics = nullptr;
+};
+
+} // end namespace genex::detail
+
+#endif // GENEX_SKIP_COUNTING_HPP
@@ -0,0 +1,120 @@
+#ifndef GENEX_SLOT_ITERATOR_HPP
+#define GENEX_SLOT_ITERATOR_HPP
+
+#include <type_traits>
+#include <utility>
+#include <boost/iterator/iterator_facade.hpp>
+#include "skip_counting.hpp"
+#include "iterator_utils.hpp"
+#include "statistics.hpp"
+
+namespace genex::detail {
+
+// Walks a single container of slots that each tell whether they hold an
+// object, stopping at those that do. SlotAccess provides
+//     static bool is_occupied(Slot const&);
+//     static Object& object(Slot&);   (and its const overload)
+//
+// Incrementing an iterator at the end leaves it there.
+template<class SlotIterator,
+         class SlotAccess,
+         class Statistics = no_statistics>
+class slot_iterator :
+        public boost::iterator_facade<
+            slot_iterator<SlotIterator, SlotAccess, Statistics>,
+            std::remove_cv_t<std::remove_reference_t<
+                decltype(SlotAccess::object(*std::declval<SlotIterator>()))>>,
+            boost::bidirectional_traversal_tag,
+            decltype(SlotAccess::object(*std::declval<SlotIterator>()))>,
+        private skip_counter<Statistics>
+{
+    using reference_type =
+        decltype(SlotAccess::object(*std::declval<SlotIterator>()));
+
+public:
+    slot_iterator() = default;
+
+    slot_iterator(SlotIterator position,
+                  SlotIterator bound,
+                  Statistics const* stats = nullptr)
+        : skip_counter<Statistics>(stats),
+          slot(position),
+          slot_end(bound)
+    {
+        skip_free_slots();
+    }
+
+    // iterator to const_iterator
+    template<class OtherSlotIterator,
+             typename std::enable_if_t<
+                 std::is_convertible_v<OtherSlotIterator, SlotIterator>,
+                 int> = 0>
+    slot_iterator(slot_iterator<OtherSlotIterator,
+                                SlotAccess,
+                                Statistics> const& other)
+        : skip_counter<Statistics>(other),
+          slot(other.slot),
+          slot_end(other.slot_end)
+    {}
+
+    friend bool operator==(slot_iterator const& it, end_sentinel_t) {
+        return it.slot == it.slot_end;
+    }
+
+    friend bool operator==(end_sentinel_t, slot_iterator const& it) {
+        return it.slot == it.slot_end;
+    }
+
+    friend bool operator!=(slot_iterator const& it, end_sentinel_t) {
+        return it.slot != it.slot_end;
+    }
+
+    friend bool operator!=(end_sentinel_t, slot_iterator const& it) {
+        return it.slot != it.slot_end;
+    }
+
+private:
+    friend class boost::iterator_core_access;
+    template<class, class, class> friend class slot_iterator;
+
+    reference_type dereference() const {
+        return SlotAccess::object(*slot);
+    }
+
+    template<class OtherSlotIterator>
+    bool equal(slot_iterator<OtherSlotIterator,
+                             SlotAccess,
+                             Statistics> const& other) const {
+        return slot == other.slot;
+    }
+
+    void increment() {
+        if(slot != slot_end) {
+            ++slot;
+            skip_free_slots();
+        }
+    }
+
+    // as for any bidirectional iterator, there must be a previous element
+    void decrement() {
+        --slot;
+        while(!SlotAccess::is_occupied(*slot)) {
+            this->count_skip();
+            --slot;
+        }
+    }
+
+    void skip_free_slots() {
+        while(slot != slot_end && !SlotAccess::is_occupied(*slot)) {
+            this->count_skip();
+            ++slot;
+        }
+    }
+
+    SlotIterator slot{};
+    SlotIterator slot_end{};
+};
+
+} // end namespace genex::detail
+
+#endif // GENEX_SLOT_ITERATOR_HPP
@@ -1,77 +1,192 @@
 #ifndef GIC_ITERATOR_HPP
 #define GIC_ITERATOR_HPP
 
-#include <functional>
+#include <iterator>
 #include <type_traits>
-#include <boost/iterator/zip_iterator.hpp>
-#include <boost/iterator/filter_iterator.hpp>
-#include <boost/iterator/transform_iterator.hpp>
+#include <utility>
+#include <boost/iterator/iterator_facade.hpp>
 #include "element_validity_embedded_in_generation.hpp"
-#include "perfect_backward.hpp"
+#include "manually_destructed.hpp"
+#include "skip_counting.hpp"
 #include "detail/iterator_utils.hpp"
+#include "statistics.hpp"
 
 namespace genex::detail {
 
-// The iterator will be constructed as follows :
-//     zip(generation_iterator, object_iterator)
-//         | filter<valid_generation>
-//         | transform<get_object>
+// Objects are wrapped in manually_destructed, except in containers that store
+// trivial objects directly.
+template<typename T, typename WhenDestroyed>
+T& unwrap_object(manually_destructed<T, WhenDestroyed>& wrapped) {
+    return *wrapped;
+}
+
+template<typename T, typename WhenDestroyed>
+T const& unwrap_object(manually_destructed<T, WhenDestroyed> const& wrapped) {
+    return *wrapped;
+}
+
+template<typename T>
+T& unwrap_object(T& object) {
+    return object;
+}
+
+template<typename ObjectIterator>
+using unwrapped_reference =
+    decltype(unwrap_object(*std::declval<ObjectIterator>()));
+
+// Walks a container of generations and the parallel container of objects,
+// stopping at the slots whose generation is valid.
 //
-// I won't use lambdas because they can't be used in unevaluated contexts.
+// Only the generations are bounded: the end of the objects is never needed,
+// and comparing two iterators only compares their generation iterators.
+// Incrementing an iterator at the end leaves it there.
+template<class GenerationIterator,
+         class ObjectIterator,
+         class Statistics = no_statistics>
+class split_iterator :
+        public boost::iterator_facade<
+            split_iterator<GenerationIterator, ObjectIterator, Statistics>,
+            std::remove_cv_t<std::remove_reference_t<
+                unwrapped_reference<ObjectIterator>>>,
+            boost::bidirectional_traversal_tag,
+            unwrapped_reference<ObjectIterator>>,
+        private skip_counter<Statistics>
+{
+public:
+    split_iterator() = default;
 
-constexpr int generation_tuple_index = 0;
-constexpr int object_tuple_index = 1;
+    split_iterator(GenerationIterator position,
+                   GenerationIterator bound,
+                   ObjectIterator object,
+                   Statistics const* stats = nullptr)
+        : skip_counter<Statistics>(stats),
+          gen(position),
+          gen_end(bound),
+          obj(object)
+    {
+        skip_free_slots();
+    }
 
-struct valid_generation {
-    template<typename RefPair>
-    bool operator()(RefPair&& zipped) const {
-        return genex::detail::is_valid(
-                    zipped.template get<generation_tuple_index>());
+    // iterator to const_iterator
+    template<class OtherGenerationIterator,
+             class OtherObjectIterator,
+             typename std::enable_if_t<
+                 std::is_convertible_v<OtherGenerationIterator,
+                                       GenerationIterator> &&
+                 std::is_convertible_v<OtherObjectIterator,
+                                       ObjectIterator>,
+                 int> = 0>
+    split_iterator(split_iterator<OtherGenerationIterator,
+                                  OtherObjectIterator,
+                                  Statistics> const& other)
+        : skip_counter<Statistics>(other),
+          gen(other.gen),
+          gen_end(other.gen_end),
+          obj(other.obj)
+    {}
+
+    friend bool operator==(split_iterator const& it, end_sentinel_t) {
+        return it.gen == it.gen_end;
     }
-};
 
-struct get_object {
-    template<typename RefPair>
-    decltype(auto) operator()(RefPair&& zipped) const {
-        return PERFECT_BACKWARD(*zipped.template get<object_tuple_index>());
+    friend bool operator==(end_sentinel_t, split_iterator const& it) {
+        return it.gen == it.gen_end;
     }
-};
 
-template<typename IteratorGetter,
-         typename GenerationContainer,
-         typename ObjectContainer>
-decltype(auto) make_zipped(GenerationContainer& gens,
-                           ObjectContainer& objs)
-{
-    return PERFECT_BACKWARD(
-                boost::make_zip_iterator(
-                    boost::make_tuple(
-                        std::invoke(IteratorGetter{}, gens),
-                        std::invoke(IteratorGetter{}, objs))));
-}
+    friend bool operator!=(split_iterator const& it, end_sentinel_t) {
+        return it.gen != it.gen_end;
+    }
 
+    friend bool operator!=(end_sentinel_t, split_iterator const& it) {
+        return it.gen != it.gen_end;
+    }
 
+private:
+    friend class boost::iterator_core_access;
+    template<class, class, class> friend class split_iterator;
+
+    unwrapped_reference<ObjectIterator> dereference() const {
+        return unwrap_object(*obj);
+    }
+
+    template<class OtherGenerationIterator, class OtherObjectIterator>
+    bool equal(split_iterator<OtherGenerationIterator,
+                              OtherObjectIterator,
+                              Statistics> const& other) const {
+        return gen == other.gen;
+    }
+
+    void increment() {
+        if(gen != gen_end) {
+            ++gen;
+            ++obj;
+            skip_free_slots();
+        }
+    }
+
+    // as for any bidirectional iterator, there must be a previous element
+    void decrement() {
+        --gen;
+        --obj;
+        while(!is_valid(*gen)) {
+            this->count_skip();
+            --gen;
+            --obj;
+        }
+    }
+
+    void skip_free_slots() {
+        while(gen != gen_end && !is_valid(*gen)) {
+            this->count_skip();
+            ++gen;
+            ++obj;
+        }
+    }
+
+    GenerationIterator gen{};
+    GenerationIterator gen_end{};
+    ObjectIterator obj{};
+};
+
+
+// The iterator starts where BeginGetter places it in the generations, at the
+// same offset in the objects, and is bounded by where EndGetter places it in
+// the generations. The objects may have more slots than there are
+// generations, e.g. the unused capacity of split_gic, hence the object
+// iterator is not simply given by BeginGetter.
 template<typename BeginGetter,
          typename EndGetter,
          typename GenerationContainer,
-         typename ObjectContainer>
-decltype(auto) make_split_gic_iterator(GenerationContainer& gens,
-                                       ObjectContainer& objs,
-                                       BeginGetter&& = BeginGetter{},
-                                       EndGetter&& = EndGetter{})
+         typename ObjectContainer,
+         typename Statistics = no_statistics>
+auto make_split_gic_iterator(GenerationContainer& gens,
+                             ObjectContainer& objs,
+                             BeginGetter&& begin_getter = BeginGetter{},
+                             EndGetter&& end_getter = EndGetter{},
+                             Statistics const* stats = nullptr)
 {
-    return PERFECT_BACKWARD(
-        boost::make_transform_iterator<get_object>(
-            boost::make_filter_iterator<valid_generation>(
-                make_zipped<BeginGetter>(gens, objs),
-                make_zipped<EndGetter>(gens, objs))));
+    using generation_iterator = decltype(begin_getter(gens));
+    using object_iterator = decltype(begin_getter(objs));
+
+    generation_iterator position = begin_getter(gens);
+    object_iterator object = begin_getter(objs);
+    std::advance(object,
+                 (position - gens.begin()) - (object - objs.begin()));
+
+    return split_iterator<generation_iterator, object_iterator, Statistics>{
+        position,
+        end_getter(gens),
+        object,
+        stats};
 }
 
-template<class GenerationContainer, class ObjectContainer>
-using split_gic_iterator =
-    decltype(make_split_gic_iterator<begin_getter, end_getter>(
-        std::declval<GenerationContainer&>(),
-        std::declval<ObjectContainer&>()));
+template<class GenerationContainer,
+         class ObjectContainer,
+         class Statistics = no_statistics>
+using split_gic_iterator = split_iterator<
+    decltype(std::declval<GenerationContainer&>().begin()),
+    decltype(std::declval<ObjectContainer&>().begin()),
+    Statistics>;
 
 } // namespace genex::detail
 
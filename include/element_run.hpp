@@ -0,0 +1,16 @@
+#ifndef GIC_ELEMENT_RUN_HPP
+#define GIC_ELEMENT_RUN_HPP
+
+#include "detail/prefix_view.hpp"
+
+namespace genex {
+
+// Consecutive living elements of a genex container, handed out by its
+// for_each_run() member function. data points to the first of size objects
+// laid out as an array, which stays valid until the container is modified.
+template<typename T>
+using element_run = detail::prefix_view<T>;
+
+} // end namespace genex
+
+#endif // GIC_ELEMENT_RUN_HPP
@@ -1,12 +1,18 @@
 #ifndef GIC_BASE_HPP
 #define GIC_BASE_HPP
 
+#include <algorithm>
+#include <cassert>
+#include <functional>
 #include <utility>
 #include <type_traits>
 
 #include <boost/optional.hpp>
 
+#include "cursor.hpp"
 #include "key.hpp"
+#include "statistics.hpp"
+#include "detail/element_validity_embedded_in_generation.hpp"
 #include "detail/genex_crtp.hpp"
 #include "detail/gic_base_forward_declaration.hpp"
 #include "detail/gic_core_access.hpp"
@@ -16,13 +22,18 @@
 namespace genex {
 
 // Base class for generationally indexed containers
+//
+// The statistics policy is an empty base class by default, so that a disabled
+// policy does not make the containers bigger.
 template<typename Derived,
          typename T,
-         typename Key>
-class gic_base : public detail::crtp_base<Derived> {
+         typename Key,
+         typename Statistics>
+class gic_base : public detail::crtp_base<Derived>, private Statistics {
 public:
     using value_type = T;
     using key_type = Key;
+    using statistics_type = Statistics;
     static_assert (is_tagged_key_v<key_type, value_type>);
 
     using generation_type = typename key_type::generation_type;
@@ -31,12 +42,49 @@ public:
 
     [[nodiscard]] element_access_type
     get(key_type const & k) {
-        return internal_get(*this, k);
+        return make_optional_ref(get_ptr(k));
     }
 
     [[nodiscard]] element_const_access_type
     get(key_type const & k) const {
-        return internal_get(*this, k);
+        return make_optional_ref(get_ptr(k));
+    }
+
+    // Same as get but without going through boost::optional: returns nullptr
+    // if there is no element for k.
+    [[nodiscard]] constexpr value_type* get_ptr(key_type const & k) {
+        return internal_get_ptr(*this, k);
+    }
+
+    [[nodiscard]] constexpr value_type const*
+    get_ptr(key_type const & k) const {
+        return internal_get_ptr(*this, k);
+    }
+
+    // Calls f with the element of k, if any. Returns whether f was called.
+    template<typename F>
+    bool visit(key_type const & k, F&& f) {
+        return internal_visit(*this, k, std::forward<F>(f));
+    }
+
+    template<typename F>
+    bool visit(key_type const & k, F&& f) const {
+        return internal_visit(*this, k, std::forward<F>(f));
+    }
+
+    // For keys that are known to be present, e.g. right after a call to
+    // is_present. Only debug builds check it.
+    [[nodiscard]] constexpr value_type& get_unchecked(key_type const & k) {
+        assert(this->as_derived().is_present(k));
+        return *detail::gic_core_access::unchecked_get(this->as_derived(),
+                                                       k.get_index());
+    }
+
+    [[nodiscard]] constexpr value_type const&
+    get_unchecked(key_type const & k) const {
+        assert(this->as_derived().is_present(k));
+        return *detail::gic_core_access::unchecked_get(this->as_derived(),
+                                                       k.get_index());
     }
 
     [[nodiscard]] element_access_type
@@ -57,8 +105,69 @@ public:
         return {};
     }
 
+    // Calls f(key, element) on at most budget elements, starting from where
+    // the cursor stopped, and returns how many it processed. Fewer than
+    // budget means that the pass is over.
+    //
+    // The cursor being an index, f may emplace and remove elements, the
+    // current one included. An emplacement may move every element, hence f
+    // may not use the element it was given after emplacing.
+    template<typename F>
+    std::size_t advance(gic_cursor& cursor, std::size_t budget, F&& f) {
+        using index_type = typename key_type::index_type;
+        auto& self = this->as_derived();
+
+        std::size_t processed = 0;
+        for(; processed < budget &&
+              cursor.position < detail::gic_core_access::slot_count(self);
+            ++cursor.position)
+        {
+            generation_type const generation =
+                detail::gic_core_access::slot_generation(self,
+                                                         cursor.position);
+            if(detail::is_valid(generation)) {
+                auto const idx = static_cast<index_type>(cursor.position);
+                std::invoke(f,
+                            key_type{idx, generation},
+                            *detail::gic_core_access::unchecked_get(self,
+                                                                    idx));
+                ++processed;
+            }
+        }
+
+        return processed;
+    }
+
+    // Number of slots, free ones included, which bounds the slot ranges of
+    // for_each_in_slots.
+    [[nodiscard]] std::size_t slots() const {
+        return detail::gic_core_access::slot_count(this->as_derived());
+    }
+
+    // Calls f(key, element) on the elements of the slots [first, last), e.g.
+    // to split a pass among threads, each with its own range. Unlike advance,
+    // f may not emplace or remove elements.
+    template<typename F>
+    void for_each_in_slots(std::size_t first, std::size_t last, F&& f) {
+        using index_type = typename key_type::index_type;
+        auto& self = this->as_derived();
+
+        last = std::min(last, detail::gic_core_access::slot_count(self));
+        for(auto position = first; position < last; ++position) {
+            generation_type const generation =
+                detail::gic_core_access::slot_generation(self, position);
+            if(detail::is_valid(generation)) {
+                auto const idx = static_cast<index_type>(position);
+                std::invoke(f,
+                            key_type{idx, generation},
+                            *detail::gic_core_access::unchecked_get(self,
+                                                                    idx));
+            }
+        }
+    }
+
     template<typename... Args>
-    [[nodiscard]] key_type emplace(Args&&... args) {
+    [[nodiscard]] constexpr key_type emplace(Args&&... args) {
         return std::get<0>(this->as_derived().emplace_and_get(
                                std::forward<Args>(args)...));
     }
@@ -100,32 +209,83 @@ public:
         return PERFECT_BACKWARD(cend());
     }
 
+    [[nodiscard]] gic_statistics statistics() const {
+        return statistics_policy().snapshot();
+    }
+
+    void reset_statistics() {
+        static_cast<Statistics&>(*this).reset();
+    }
+
 protected:
     gic_base() = default;
 
+    // The statistics describe what happened to one container object, they are
+    // neither copied nor moved along with the elements. The swap of derived
+    // containers leaves them in place too.
+    constexpr gic_base(gic_base const&)
+        : detail::crtp_base<Derived>(), Statistics() {}
+    constexpr gic_base(gic_base&&) noexcept
+        : detail::crtp_base<Derived>(), Statistics() {}
+
+    constexpr gic_base& operator=(gic_base const&) {
+        return *this;
+    }
+
+    constexpr gic_base& operator=(gic_base&&) noexcept {
+        return *this;
+    }
+
+    constexpr Statistics const& statistics_policy() const {
+        return *this;
+    }
+
 private:
 
     template<typename V>
     static boost::optional<V&> make_optional_ref(V* ptr) {
+        if(ptr == nullptr) {
+            return {};
+        }
+
         return {*ptr};
     }
 
+    template<class Self>
+    using element_pointer = std::conditional_t<
+        std::is_const_v<std::remove_reference_t<Self>>,
+        value_type const*,
+        value_type*>;
+
     // This is clearly overkill, I just wanted to see if I could write
     // the logic of this function only once instead of once for const
     // this and once for non-const this
     template<class Self>
-    static decltype(auto) internal_get(
+    static constexpr element_pointer<Self> internal_get_ptr(
             Self&& self,
             key_type const & k)
     {
-        if(self.as_derived().is_present(k)) {
-            return make_optional_ref(
-                        detail::gic_core_access::unchecked_get(
-                            self.as_derived(),
-                            k.get_index()));
+        bool const present = self.as_derived().is_present(k);
+        self.statistics_policy().on_get(present);
+
+        if(present) {
+            return detail::gic_core_access::unchecked_get(
+                        self.as_derived(),
+                        k.get_index());
+        }
+
+        return nullptr;
+    }
+
+    template<class Self, typename F>
+    static bool internal_visit(Self&& self, key_type const & k, F&& f) {
+        auto* ptr = internal_get_ptr(self, k);
+        if(ptr != nullptr) {
+            std::invoke(std::forward<F>(f), *ptr);
+            return true;
         }
 
-        return self.failed_get();
+        return false;
     }
 };
 
@@ -6,16 +6,18 @@
 #include <functional>
 #include <algorithm>
 #include <iterator>
+#include <memory>
 #include <type_traits>
 #include <variant>
 
-#include <boost/iterator/filter_iterator.hpp>
-#include <boost/iterator/transform_iterator.hpp>
-
 #include "detail/gic_core_access.hpp"
 #include "detail/perfect_backward.hpp"
 #include "detail/key_placeholding.hpp"
+#include "detail/slot_iterator.hpp"
 #include "gic_with_generations.hpp"
+#include "element_run.hpp"
+#include "memory_usage.hpp"
+#include "statistics.hpp"
 
 
 namespace genex {
@@ -32,7 +34,8 @@ template<typename T,
          template<class...> class ObjectContainer,
          class Key,
          class GenerationContainer,
-         template<class...> class Variant = std::variant>
+         template<class...> class Variant = std::variant,
+         class Statistics = no_statistics>
 class gic_fit :
         public gic_with_generations<
             gic_fit<
@@ -40,15 +43,17 @@ class gic_fit :
                 ObjectContainer,
                 Key,
                 GenerationContainer,
-                Variant>,
+                Variant,
+                Statistics>,
             T,
             Key,
-            GenerationContainer
+            GenerationContainer,
+            Statistics
         >
 {
 private:
-    using parent_type =
-        gic_with_generations<gic_fit, T, Key, GenerationContainer>;
+    using parent_type = gic_with_generations<
+        gic_fit, T, Key, GenerationContainer, Statistics>;
 
     // without this line, we can only refer to 'generations' with
     // 'this->generations' because the base class is templated.
@@ -69,12 +74,18 @@ private:
     wrapped_object_container objects;
 
     // head of the singly-linked list of free elements
-    index_type free_head;
+    index_type free_head{};
     index_type number_of_free_elements{0};
 
     void unchecked_erasure(index_type&& idx) {
         ++generations[idx];
-        objects[idx].template emplace<0>(free_head);
+        if constexpr (std::is_trivially_copyable_v<wrapped_type>) {
+            // a plain store instead of resetting the alternative in place
+            objects[idx] = wrapped_type{std::in_place_index<0>, free_head};
+        }
+        else {
+            objects[idx].template emplace<0>(free_head);
+        }
         free_head = idx;
         ++number_of_free_elements;
     }
@@ -92,64 +103,39 @@ private:
 
     // ===== Iterator ====
 
-    // filter
-    struct is_slot_occupied {
-        // making this function 'const' is necessary. It was HARD to find out.
-        bool operator()(wrapped_type const& slot) const {
+    // the object alternative of the variant, if it holds one
+    struct slot_access {
+        static bool is_occupied(wrapped_type const& slot) {
             return slot.index() == 1;
         }
-    };
 
-    // transform
-    struct slot_unwrapper {
-        reference operator()(wrapped_type & slot) const {
+        static reference object(wrapped_type & slot) {
             return std::get<1>(slot);
         }
 
-        const_reference operator()(wrapped_type const& slot) const {
+        static const_reference object(wrapped_type const& slot) {
             return std::get<1>(slot);
         }
     };
 
-    // Main implementation of the iterator.
-    // The rest is used to retrieve its types (const and non-const).
-    template <typename ObjCont, typename BG, typename EG>
-    static decltype(auto)
-    make_gic_fit_iterator(ObjCont& container,
-                          BG begin_getter,
-                          EG end_getter)
-    {
-        return PERFECT_BACKWARD(
-            boost::make_transform_iterator<slot_unwrapper>(
-                boost::make_filter_iterator<is_slot_occupied>(
-                    begin_getter(container),
-                    end_getter(container))));
-    }
-
     template <typename Self, typename BG, typename EG>
-    static decltype(auto)
-    make_iterator(Self& self, BG begin_getter, EG end_getter) {
-        return PERFECT_BACKWARD(
-            make_gic_fit_iterator(self.objects,
-                                  begin_getter,
-                                  end_getter));
+    static auto make_iterator(Self& self, BG begin_getter, EG end_getter) {
+        using slot_iterator = decltype(begin_getter(self.objects));
+        return detail::slot_iterator<slot_iterator, slot_access, Statistics>{
+            begin_getter(self.objects),
+            end_getter(self.objects),
+            &self.statistics_policy()};
     }
 
-    template<bool IsConst>
-    using conditionally_const_container = std::conditional_t<
-        IsConst,
-        const wrapped_object_container,
-        wrapped_object_container>;
-
-    template<bool IsConst>
-    using conditionally_const_iterator = decltype(make_gic_fit_iterator(
-        std::declval<conditionally_const_container<IsConst>&>(),
-        detail::begin_getter_v,
-        detail::end_getter_v));
-
 public:
-    using iterator = conditionally_const_iterator<false>;
-    using const_iterator = conditionally_const_iterator<true>;
+    using iterator = detail::slot_iterator<
+        typename wrapped_object_container::iterator,
+        slot_access,
+        Statistics>;
+    using const_iterator = detail::slot_iterator<
+        typename wrapped_object_container::const_iterator,
+        slot_access,
+        Statistics>;
 
 
     // ===== Core functionalities =====
@@ -159,6 +145,13 @@ public:
     // elements, which are variant instances that call the destructor of the
     // index or object they hold.
 
+    // The free slots hold the free list, so copying every variant is what
+    // copying the container takes. For trivially copyable objects, those
+    // copies are trivial.
+    [[nodiscard]] gic_fit clone() const {
+        return *this;
+    }
+
     template<typename... Args>
     [[nodiscard]] std::pair<key_type, T&> emplace_and_get(Args&&... args) {
         if (number_of_free_elements != 0) {
@@ -173,27 +166,70 @@ public:
             --number_of_free_elements;
 
             T& emplaced_obj = slot.template emplace<1>(
-                        detail::forward_arg_or_key<Args>(args, k)...);
+                        detail::forward_arg_or_key<Args>(
+                            std::forward<Args>(args), k)...);
 
+            this->statistics_policy().on_emplace_in_free_slot();
             return {k, emplaced_obj};
         }
         else {
+            auto const old_capacity = objects.capacity();
             key_type k{index_type{objects.size()}, generation_type{}};
             auto& slot = objects.emplace_back(
                         std::in_place_index<1>,
-                        detail::forward_arg_or_key<Args>(args, k)...);
+                        detail::forward_arg_or_key<Args>(
+                            std::forward<Args>(args), k)...);
 
             generations.push_back(k.get_generation());
+            this->statistics_policy().on_emplace_at_back(
+                        objects.capacity() != old_capacity);
             return {k, std::get<1>(slot)};
         }
     }
 
     void remove(key_type const &k) {
-        if(this->is_present(k)) {
+        bool const present = this->is_present(k);
+        this->statistics_policy().on_remove(present);
+
+        if(present) {
             auto idx = k.get_index();
             unchecked_erasure(std::forward<index_type>(idx));
         }
     }
+
+    // The free indexes are stored in the free slots, so they take no memory
+    // of their own.
+    [[nodiscard]] gic_memory_usage memory_usage() const {
+        gic_memory_usage usage;
+        usage.objects = detail::memory_of(objects);
+        usage.generations = detail::memory_of(generations);
+        detail::count_slots(generations, usage);
+        return usage;
+    }
+
+    // Same as split_gic::for_each_run, but each slot is a variant that stores
+    // its alternative next to the object, so the objects are never laid out
+    // as an array and each run is a single element.
+    template<typename F>
+    void for_each_run(F&& f) {
+        for_each_run_in(*this, f);
+    }
+
+    template<typename F>
+    void for_each_run(F&& f) const {
+        for_each_run_in(*this, f);
+    }
+
+private:
+    template<class Self, typename F>
+    static void for_each_run_in(Self& self, F& f) {
+        for(auto& slot : self.objects) {
+            if(slot_access::is_occupied(slot)) {
+                f(detail::prefix_view{std::addressof(slot_access::object(slot)),
+                                      std::size_t{1}});
+            }
+        }
+    }
 };
 
 } // end namespace genex
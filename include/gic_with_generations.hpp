@@ -1,6 +1,7 @@
 #ifndef GIC_WITH_GENERATIONS_HPP
 #define GIC_WITH_GENERATIONS_HPP
 
+#include <cstddef>
 #include <utility>
 
 #include "gic_base.hpp"
@@ -12,18 +13,31 @@ namespace genex {
 template<typename Derived,
          typename T,
          typename Key,
-         typename GenerationContainer>
-class gic_with_generations : public gic_base<Derived, T, Key> {
+         typename GenerationContainer,
+         typename Statistics>
+class gic_with_generations : public gic_base<Derived, T, Key, Statistics> {
 public:
+    // Keys may come from a later state of the container, e.g. when they are
+    // looked up in a snapshot or a copy, hence the bounds check.
     bool is_present(Key const &k) const {
-        return k.get_generation() == generations[k.get_index()];
+        return k.get_index() < generations.size() &&
+               k.get_generation() == generations[k.get_index()];
     }
 
 protected:
-    using parent_type = gic_base<Derived, T, Key>;
+    using parent_type = gic_base<Derived, T, Key, Statistics>;
 
     gic_with_generations() = default;
 
+    static std::size_t slot_count(gic_with_generations const& self) {
+        return self.generations.size();
+    }
+
+    static auto const& slot_generation(gic_with_generations const& self,
+                                       std::size_t idx) {
+        return self.generations[idx];
+    }
+
     GenerationContainer generations;
 };
 
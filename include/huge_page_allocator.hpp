@@ -0,0 +1,175 @@
+#ifndef HUGE_PAGE_ALLOCATOR_HPP
+#define HUGE_PAGE_ALLOCATOR_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <new>
+#include <vector>
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+#include "key.hpp"
+#include "split_gic.hpp"
+
+namespace genex {
+
+constexpr std::size_t huge_page_size = std::size_t{2} << 20;
+
+namespace detail {
+
+inline std::size_t round_to_huge_pages(std::size_t bytes) noexcept {
+    return (bytes + huge_page_size - 1) / huge_page_size * huge_page_size;
+}
+
+#if defined(__linux__)
+
+// Maps one more huge page than asked for and unmaps what is around the first
+// aligned address, since mmap only aligns on a base page.
+inline void* map_huge_pages(std::size_t bytes, bool prefault) {
+    auto const padded = bytes + huge_page_size;
+    void* mapped = ::mmap(nullptr, padded, PROT_READ | PROT_WRITE,
+                          MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if(mapped == MAP_FAILED) {
+        throw std::bad_alloc();
+    }
+
+    auto* const first = static_cast<char*>(mapped);
+    auto const address = reinterpret_cast<std::uintptr_t>(first);
+    auto const head = (huge_page_size - address % huge_page_size) %
+                      huge_page_size;
+    auto* const aligned = first + head;
+    if(head != 0) {
+        ::munmap(first, head);
+    }
+    if(padded - head != bytes) {
+        ::munmap(aligned + bytes, padded - head - bytes);
+    }
+
+    // only a hint: without transparent huge pages, base pages are used
+    ::madvise(aligned, bytes, MADV_HUGEPAGE);
+
+    // After the advice, so that the pages faulted in are huge ones. Mapping
+    // with MAP_POPULATE would fault them in before.
+    if(prefault) {
+#if defined(MADV_POPULATE_WRITE)
+        if(::madvise(aligned, bytes, MADV_POPULATE_WRITE) == 0) {
+            return aligned;
+        }
+#endif
+        auto const page = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+        for(std::size_t offset = 0; offset < bytes; offset += page) {
+            static_cast<char volatile*>(aligned)[offset] = 0;
+        }
+    }
+
+    return aligned;
+}
+
+inline void unmap_huge_pages(void* p, std::size_t bytes) noexcept {
+    ::munmap(p, bytes);
+}
+
+#else
+
+inline void* map_huge_pages(std::size_t bytes, bool) {
+    return ::operator new(bytes, std::align_val_t{huge_page_size});
+}
+
+inline void unmap_huge_pages(void* p, std::size_t) noexcept {
+    ::operator delete(p, std::align_val_t{huge_page_size});
+}
+
+#endif
+
+} // end namespace detail
+
+// Allocates the storage of big containers in 2 MiB pages aligned on 2 MiB,
+// and advises Linux to back them with transparent huge pages, so that random
+// accesses and full passes over tens of millions of slots take fewer TLB
+// misses. With Prefault, the pages are faulted in when the storage is
+// allocated, i.e. when the container grows, instead of on first access.
+//
+// Allocations smaller than a huge page, which would waste most of it, come
+// from operator new. Elsewhere than on Linux, every allocation does, aligned
+// on 2 MiB for the big ones.
+template<typename T, bool Prefault = false>
+class huge_page_allocator {
+public:
+    using value_type = T;
+
+    // Prefault is not a type, so allocator_traits cannot rebind by itself.
+    template<typename U>
+    struct rebind {
+        using other = huge_page_allocator<U, Prefault>;
+    };
+
+    huge_page_allocator() = default;
+
+    template<typename U>
+    huge_page_allocator(huge_page_allocator<U, Prefault> const&) noexcept {}
+
+    [[nodiscard]] T* allocate(std::size_t n) {
+        if(n > std::numeric_limits<std::size_t>::max() / sizeof(T)) {
+            throw std::bad_array_new_length();
+        }
+
+        auto const bytes = n * sizeof(T);
+        if(bytes < huge_page_size) {
+            return static_cast<T*>(
+                ::operator new(bytes, std::align_val_t{alignof(T)}));
+        }
+
+        return static_cast<T*>(
+            detail::map_huge_pages(detail::round_to_huge_pages(bytes),
+                                   Prefault));
+    }
+
+    void deallocate(T* p, std::size_t n) noexcept {
+        auto const bytes = n * sizeof(T);
+        if(bytes < huge_page_size) {
+            ::operator delete(p, std::align_val_t{alignof(T)});
+        }
+        else {
+            detail::unmap_huge_pages(p, detail::round_to_huge_pages(bytes));
+        }
+    }
+
+    template<typename U>
+    friend bool operator==(huge_page_allocator const&,
+                           huge_page_allocator<U, Prefault> const&) noexcept {
+        return true;
+    }
+
+    template<typename U>
+    friend bool operator!=(huge_page_allocator const&,
+                           huge_page_allocator<U, Prefault> const&) noexcept {
+        return false;
+    }
+};
+
+template<typename T>
+using huge_page_vector = std::vector<T, huge_page_allocator<T>>;
+
+template<typename T>
+using prefaulted_huge_page_vector =
+    std::vector<T, huge_page_allocator<T, true>>;
+
+// A split_gic whose objects, generations and free indexes are all in huge
+// pages.
+template<typename T,
+         class Key = key<T>,
+         template<class...> class Vector = huge_page_vector>
+using huge_page_split_gic = split_gic<
+    T,
+    Vector,
+    Key,
+    Vector<typename Key::index_type>,
+    Vector<typename Key::generation_type>>;
+
+} // end namespace genex
+
+#endif // HUGE_PAGE_ALLOCATOR_HPP
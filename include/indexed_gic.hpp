@@ -0,0 +1,404 @@
+#ifndef INDEXED_GIC_HPP
+#define INDEXED_GIC_HPP
+
+#include <cstddef>
+#include <functional>
+#include <map>
+#include <tuple>
+#include <unordered_map>
+#include <utility>
+#include <type_traits>
+
+#include <boost/optional.hpp>
+
+#include "secondary_map.hpp"
+
+namespace genex {
+
+// Indexes of an indexed_gic, from the value that projection returns for an
+// element to the key of that element. Several elements may share a value.
+template<class Projection>
+struct hashed_index {
+    template<typename Attribute, typename Key>
+    using map_type = std::unordered_multimap<Attribute, Key>;
+
+    // a rehash invalidates every iterator
+    static constexpr bool stable_iterators = false;
+
+    Projection projection;
+};
+
+template<class Projection>
+hashed_index(Projection) -> hashed_index<Projection>;
+
+template<class Projection>
+struct ordered_index {
+    template<typename Attribute, typename Key>
+    using map_type = std::multimap<Attribute, Key>;
+
+    static constexpr bool stable_iterators = true;
+
+    Projection projection;
+};
+
+template<class Projection>
+ordered_index(Projection) -> ordered_index<Projection>;
+
+namespace detail {
+
+// The entries of an index, along with where the entry of each key is, so that
+// it is found without projecting the element nor scanning the entries of equal
+// attributes.
+template<class Index, typename T, class Key>
+class attribute_index {
+    using projection_type = decltype(Index::projection);
+
+public:
+    using attribute_type = std::decay_t<
+        std::invoke_result_t<projection_type const&, T const&>>;
+    using map_type = typename Index::template map_type<attribute_type, Key>;
+    using node_type = typename map_type::node_type;
+
+    explicit attribute_index(Index index) :
+        projection(std::move(index.projection))
+    {}
+
+    void insert(Key const& k, T const& object) {
+        auto const buckets = bucket_count();
+        auto const it = entries.emplace(project(object), k);
+        try {
+            track(k, it, buckets);
+        }
+        catch(...) {
+            positions.remove(k);
+            entries.erase(it);
+            throw;
+        }
+    }
+
+    // Takes the entry of k out of the index, leaving the node empty if there
+    // is none.
+    node_type extract(Key const& k) {
+        auto const* position = positions.get_ptr(k);
+        if(position == nullptr) {
+            return {};
+        }
+
+        auto node = entries.extract(*position);
+        positions.remove(k);
+        return node;
+    }
+
+    // Puts the extracted entry of k back, under the current value of the
+    // object. Reusing the node allocates nothing.
+    void reinsert(node_type&& node, Key const& k, T const& object) {
+        if(!node.empty()) {
+            node.key() = project(object);
+            auto const buckets = bucket_count();
+            auto const it = entries.insert(std::move(node));
+            // the slot of k in positions is already there
+            track(k, it, buckets);
+        }
+    }
+
+    void erase(Key const& k) {
+        (void)extract(k);
+    }
+
+    map_type const& map() const noexcept {
+        return entries;
+    }
+
+private:
+    using iterator = typename map_type::iterator;
+
+    projection_type projection;
+    map_type entries;
+    secondary_map<Key, iterator> positions;
+
+    attribute_type project(T const& object) const {
+        return std::invoke(projection, object);
+    }
+
+    // changes when the iterators to the entries are invalidated
+    std::size_t bucket_count() const noexcept {
+        if constexpr (Index::stable_iterators) {
+            return 0;
+        }
+        else {
+            return entries.bucket_count();
+        }
+    }
+
+    // Records where the entry of k was inserted, or where every entry is if
+    // the insertion rehashed the entries.
+    void track(Key const& k, iterator it, std::size_t buckets) {
+        if(bucket_count() != buckets) {
+            for(auto entry = entries.begin(); entry != entries.end(); ++entry) {
+                positions.insert(entry->second, entry);
+            }
+        }
+        else {
+            positions.insert(k, it);
+        }
+    }
+};
+
+} // end namespace detail
+
+// A genex container along with indexes from attributes of its elements to
+// their keys, such as an owner id or a name, so that finding elements by
+// attribute takes a hash lookup or a binary search instead of a scan.
+//
+// The indexes are updated when elements are emplaced or removed. Elements are
+// only handed out as const, except through modify(), whose accessor updates
+// the indexes when committed or when it goes out of scope, so that they never
+// go stale.
+template<class Gic, class... Indexes>
+class indexed_gic {
+public:
+    using container_type = Gic;
+    using value_type = typename Gic::value_type;
+    using key_type = typename Gic::key_type;
+    using element_const_access_type = boost::optional<value_type const&>;
+
+private:
+    using index_tuple =
+        std::tuple<detail::attribute_index<Indexes, value_type, key_type>...>;
+    using node_tuple = std::tuple<typename detail::attribute_index<
+        Indexes, value_type, key_type>::node_type...>;
+
+public:
+    template<std::size_t I>
+    using attribute_type =
+        typename std::tuple_element_t<I, index_tuple>::attribute_type;
+
+    // Reindexes its element when committed, or else when destroyed. Holds
+    // nothing if the key given to modify() was not present.
+    //
+    // If reindexing throws, e.g. because a projection did, the element is
+    // removed, so that no index misses it. commit() then rethrows, while the
+    // destructor cannot.
+    class modifier {
+    public:
+        modifier(modifier&& other) noexcept :
+            owner(std::exchange(other.owner, nullptr)),
+            object(other.object),
+            k(std::move(other.k)),
+            nodes(std::move(other.nodes))
+        {}
+
+        modifier(modifier const&) = delete;
+        modifier& operator=(modifier const&) = delete;
+        modifier& operator=(modifier&&) = delete;
+
+        ~modifier() {
+            try {
+                commit();
+            }
+            catch(...) {}
+        }
+
+        void commit() {
+            if(owner != nullptr) {
+                std::exchange(owner, nullptr)->reindex_or_remove(*k, nodes);
+            }
+        }
+
+        explicit operator bool() const noexcept {
+            return object != nullptr;
+        }
+
+        value_type& operator*() const noexcept {
+            return *object;
+        }
+
+        value_type* operator->() const noexcept {
+            return object;
+        }
+
+    private:
+        friend class indexed_gic;
+
+        modifier() = default;
+
+        // null once committed
+        indexed_gic* owner = nullptr;
+        value_type* object = nullptr;
+        boost::optional<key_type> k;
+        node_tuple nodes;
+    };
+
+    explicit indexed_gic(Indexes... index_definitions) :
+        indexes(std::move(index_definitions)...)
+    {}
+
+    template<typename... Args>
+    [[nodiscard]] key_type emplace(Args&&... args) {
+        return std::get<0>(emplace_and_get(std::forward<Args>(args)...));
+    }
+
+    template<typename... Args>
+    [[nodiscard]] std::pair<key_type, value_type const&>
+    emplace_and_get(Args&&... args) {
+        auto [k, object] = gic.emplace_and_get(std::forward<Args>(args)...);
+
+        try {
+            std::apply([&, &k = k, &object = object](auto&... index) {
+                (index.insert(k, object), ...);
+            }, indexes);
+        }
+        catch(...) {
+            std::apply([&, &k = k](auto&... index) {
+                (index.erase(k), ...);
+            }, indexes);
+            gic.remove(k);
+            throw;
+        }
+
+        return {k, object};
+    }
+
+    void remove(key_type const& k) {
+        if(gic.is_present(k)) {
+            std::apply([&](auto&... index) {
+                (index.erase(k), ...);
+            }, indexes);
+            gic.remove(k);
+        }
+    }
+
+    [[nodiscard]] bool is_present(key_type const& k) const {
+        return gic.is_present(k);
+    }
+
+    [[nodiscard]] value_type const* get_ptr(key_type const& k) const {
+        return gic.get_ptr(k);
+    }
+
+    [[nodiscard]] element_const_access_type get(key_type const& k) const {
+        return gic.get(k);
+    }
+
+    [[nodiscard]] element_const_access_type
+    operator[](key_type const& k) const {
+        return get(k);
+    }
+
+    // The element of k, if present, to be modified until the modifier is
+    // committed or destroyed. Its entries are taken out of the indexes
+    // meanwhile, so it is not found by attribute until then, and the container
+    // must not be modified otherwise.
+    [[nodiscard]] modifier modify(key_type const& k) {
+        modifier m;
+        if(auto* object = gic.get_ptr(k)) {
+            m.owner = this;
+            m.object = object;
+            m.k = k;
+            extract_all(k, m.nodes, std::index_sequence_for<Indexes...>{});
+        }
+        return m;
+    }
+
+    // Calls f with the element of k, if present, then reindexes it. Returns
+    // whether it was present.
+    template<typename F>
+    bool modify(key_type const& k, F&& f) {
+        auto m = modify(k);
+        if(m) {
+            std::invoke(std::forward<F>(f), *m);
+            m.commit();
+        }
+        return static_cast<bool>(m);
+    }
+
+    // The key of one of the elements whose attribute is equal to value.
+    template<std::size_t I>
+    [[nodiscard]] boost::optional<key_type>
+    find(attribute_type<I> const& value) const {
+        auto const& map = index<I>();
+        auto it = map.find(value);
+        if(it == map.end()) {
+            return {};
+        }
+        return it->second;
+    }
+
+    // The entries, pairs of an attribute and a key, of the elements whose
+    // attribute is equal to value.
+    template<std::size_t I>
+    [[nodiscard]] auto equal_range(attribute_type<I> const& value) const {
+        return index<I>().equal_range(value);
+    }
+
+    // The underlying map of index I, e.g. for the range queries of an
+    // ordered_index.
+    template<std::size_t I>
+    [[nodiscard]] auto const& index() const noexcept {
+        return std::get<I>(indexes).map();
+    }
+
+    [[nodiscard]] Gic const& container() const noexcept {
+        return gic;
+    }
+
+    auto begin() const {
+        return gic.cbegin();
+    }
+
+    auto end() const {
+        return gic.cend();
+    }
+
+    auto cbegin() const {
+        return gic.cbegin();
+    }
+
+    auto cend() const {
+        return gic.cend();
+    }
+
+private:
+    Gic gic;
+    index_tuple indexes;
+
+    template<std::size_t... Is>
+    void extract_all(key_type const& k,
+                     node_tuple& nodes,
+                     std::index_sequence<Is...>)
+    {
+        ((std::get<Is>(nodes) = std::get<Is>(indexes).extract(k)), ...);
+    }
+
+    // The nodes that were not reinserted are freed along with the modifier.
+    void reindex_or_remove(key_type const& k, node_tuple& nodes) {
+        try {
+            reindex(k, nodes, std::index_sequence_for<Indexes...>{});
+        }
+        catch(...) {
+            remove(k);
+            throw;
+        }
+    }
+
+    template<std::size_t... Is>
+    void reindex(key_type const& k,
+                 node_tuple& nodes,
+                 std::index_sequence<Is...>)
+    {
+        auto const& object = *gic.get_ptr(k);
+        (std::get<Is>(indexes).reinsert(std::move(std::get<Is>(nodes)),
+                                        k,
+                                        object),
+         ...);
+    }
+};
+
+template<class Gic, class... Indexes>
+indexed_gic<Gic, Indexes...> make_indexed_gic(Indexes... index_definitions) {
+    return indexed_gic<Gic, Indexes...>(std::move(index_definitions)...);
+}
+
+} // end namespace genex
+
+#endif // INDEXED_GIC_HPP
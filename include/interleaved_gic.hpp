@@ -0,0 +1,375 @@
+#ifndef INTERLEAVED_GIC_HPP
+#define INTERLEAVED_GIC_HPP
+
+#include <cstddef>
+#include <cstring>
+#include <utility>
+#include <vector>
+#include <type_traits>
+
+#include "gic_base.hpp"
+#include "key.hpp"
+#include "relocation.hpp"
+#include "statistics.hpp"
+#include "detail/manually_destructed.hpp"
+#include "detail/element_validity_embedded_in_generation.hpp"
+#include "detail/gic_core_access.hpp"
+#include "detail/iterator_utils.hpp"
+#include "detail/perfect_backward.hpp"
+#include "detail/key_placeholding.hpp"
+#include "detail/slot_iterator.hpp"
+
+namespace genex {
+
+namespace detail {
+
+template<typename... Ts>
+constexpr std::size_t max_alignment(std::size_t at_least) {
+    std::size_t alignment = at_least;
+    ((alignment = alignment < alignof(Ts) ? alignof(Ts) : alignment), ...);
+    return alignment;
+}
+
+// A generation and the object it validates, side by side. Alignment can be
+// raised, e.g. to the size of a cache line so that no slot straddles two.
+template<typename T, typename Generation, std::size_t Alignment>
+struct alignas(max_alignment<Generation, manually_destructed<T>>(Alignment))
+interleaved_slot_layout {
+    Generation generation;
+    manually_destructed<T> object;
+
+    // does not construct anything, like manually_destructed
+    interleaved_slot_layout() {}
+
+    // slot without object
+    explicit interleaved_slot_layout(Generation const& g) : generation(g) {}
+
+    template<typename... Args>
+    interleaved_slot_layout(Generation const& g,
+                            std::in_place_t,
+                            Args&&... args)
+        : generation(g),
+          object(std::in_place, std::forward<Args>(args)...)
+    {}
+};
+
+// Slots of trivially copyable objects are copied byte per byte.
+template<typename T,
+         typename Generation,
+         std::size_t Alignment,
+         bool = std::is_trivially_copyable_v<T>>
+struct interleaved_slot : interleaved_slot_layout<T, Generation, Alignment> {
+    using interleaved_slot_layout<T, Generation, Alignment>::
+        interleaved_slot_layout;
+};
+
+// Unlike manually_destructed, a slot knows whether it holds an object: copying
+// it copies the object, if its generation is valid. The slots container still
+// never grows by itself, since that would leave the objects of the old slots
+// undestroyed.
+template<typename T, typename Generation, std::size_t Alignment>
+struct interleaved_slot<T, Generation, Alignment, false> :
+        interleaved_slot_layout<T, Generation, Alignment> {
+    using interleaved_slot_layout<T, Generation, Alignment>::
+        interleaved_slot_layout;
+
+    interleaved_slot() {}
+
+    interleaved_slot(interleaved_slot const& other)
+        : interleaved_slot_layout<T, Generation, Alignment>(other.generation)
+    {
+        if(is_valid(other.generation)) {
+            this->object.emplace(*other.object);
+        }
+    }
+
+    interleaved_slot& operator=(interleaved_slot const&) = delete;
+};
+
+} // end namespace detail
+
+// A generationnally indexed container where each object is stored next to its
+// generation, so that looking an element up by key touches a single cache line
+// most of the time. split_gic is better suited to iteration: its generations
+// are packed together and the free slots are skipped without loading objects.
+//
+// As in split_gic, the indexes of freed objects are in a separate container and
+// whether an object is free or not is determined by the generation.
+template<typename T,
+         template<class...> class SlotContainer = std::vector,
+         class Key = key<T>,
+         class IndexContainer = std::vector<typename Key::index_type>,
+         std::size_t Alignment = 0,
+         class Statistics = no_statistics>
+class interleaved_gic :
+        public gic_base<
+            interleaved_gic<
+                T,
+                SlotContainer,
+                Key,
+                IndexContainer,
+                Alignment,
+                Statistics>,
+            T,
+            Key,
+            Statistics
+        >
+{
+private:
+    using parent_type = gic_base<interleaved_gic, T, Key, Statistics>;
+
+public:
+    using value_type = T;
+    using reference = T&;
+    using const_reference = T const&;
+    using key_type = typename parent_type::key_type;
+    using index_type = typename key_type::index_type;
+    using generation_type = typename key_type::generation_type;
+
+    using slot_type =
+        detail::interleaved_slot<T, generation_type, Alignment>;
+    using slot_container = SlotContainer<slot_type>;
+
+private:
+    slot_container slots;
+    IndexContainer free_indexes;
+
+    // ===== CRTP overrides =====
+
+    friend class detail::gic_core_access;
+
+    template<class Self>
+    static decltype(auto) unchecked_get(Self& self, index_type const& idx) {
+        return PERFECT_BACKWARD(self.slots[idx].object.get_pointer());
+    }
+
+    static std::size_t slot_count(interleaved_gic const& self) {
+        return self.slots.size();
+    }
+
+    static generation_type const&
+    slot_generation(interleaved_gic const& self, std::size_t idx) {
+        return self.slots[idx].generation;
+    }
+
+
+    // ===== Iterator ====
+
+    // the object of a slot, if its generation is valid
+    struct slot_access {
+        static bool is_occupied(slot_type const& slot) {
+            return detail::is_valid(slot.generation);
+        }
+
+        static reference object(slot_type & slot) {
+            return *slot.object;
+        }
+
+        static const_reference object(slot_type const& slot) {
+            return *slot.object;
+        }
+    };
+
+    template <typename Self, typename BG, typename EG>
+    static auto make_iterator(Self& self, BG begin_getter, EG end_getter) {
+        using slot_iterator = decltype(begin_getter(self.slots));
+        return detail::slot_iterator<slot_iterator, slot_access, Statistics>{
+            begin_getter(self.slots),
+            end_getter(self.slots),
+            &self.statistics_policy()};
+    }
+
+public:
+    using iterator = detail::slot_iterator<
+        typename slot_container::iterator,
+        slot_access,
+        Statistics>;
+    using const_iterator = detail::slot_iterator<
+        typename slot_container::const_iterator,
+        slot_access,
+        Statistics>;
+
+
+    // ===== Core functionalities =====
+
+    interleaved_gic() = default;
+
+    // Only the living objects are copied, unless the slots are trivially
+    // copyable, in which case they are all copied at once.
+    interleaved_gic(interleaved_gic const& other) :
+        parent_type(other),
+        free_indexes(other.free_indexes)
+    {
+        auto const size = other.slots.size();
+
+        if constexpr (std::is_trivially_copyable_v<slot_type>) {
+            // default construction of slots is a no-op
+            slots.resize(size);
+            if(size != 0) {
+                std::memcpy(slots.data(),
+                            other.slots.data(),
+                            size * sizeof(slot_type));
+            }
+        }
+        else {
+            slots.reserve(size);
+            try {
+                for(auto const& slot : other.slots) {
+                    if(detail::is_valid(slot.generation)) {
+                        slots.emplace_back(slot.generation,
+                                           std::in_place,
+                                           *slot.object);
+                    }
+                    else {
+                        slots.emplace_back(slot.generation);
+                    }
+                }
+            }
+            catch(...) {
+                destroy_live_objects();
+                throw;
+            }
+        }
+    }
+
+    interleaved_gic(interleaved_gic&& other) noexcept : interleaved_gic() {
+        swap(other);
+    }
+
+    interleaved_gic& operator=(interleaved_gic const& other) {
+        interleaved_gic copy(other);
+        swap(copy);
+        return *this;
+    }
+
+    interleaved_gic& operator=(interleaved_gic&& other) noexcept {
+        interleaved_gic moved(std::move(other));
+        swap(moved);
+        return *this;
+    }
+
+    ~interleaved_gic() {
+        destroy_live_objects();
+    }
+
+    [[nodiscard]] interleaved_gic clone() const {
+        return *this;
+    }
+
+    // The statistics stay with each container, as with copies and moves,
+    // which are built on swap.
+    void swap(interleaved_gic& other) noexcept {
+        using std::swap;
+        swap(slots, other.slots);
+        swap(free_indexes, other.free_indexes);
+    }
+
+    friend void swap(interleaved_gic& a, interleaved_gic& b) noexcept {
+        a.swap(b);
+    }
+
+    bool is_present(key_type const& k) const {
+        return k.get_index() < slots.size() &&
+               k.get_generation() == slots[k.get_index()].generation;
+    }
+
+    template<typename... Args>
+    [[nodiscard]] std::pair<key_type, T&> emplace_and_get(Args&&... args) {
+        if (free_indexes.empty()) {
+            bool const reallocating = slots.size() == slots.capacity();
+            if(reallocating) {
+                grow_slots();
+            }
+
+            key_type k{index_type{slots.size()}, generation_type{}};
+            auto& slot = slots.emplace_back(
+                        k.get_generation(),
+                        std::in_place,
+                        detail::forward_arg_or_key<Args>(
+                            std::forward<Args>(args), k)...);
+
+            this->statistics_policy().on_emplace_at_back(reallocating);
+            return {k, *slot.object};
+        }
+        else {
+            auto idx = free_indexes.back();
+            free_indexes.pop_back();
+            auto& slot = slots[idx];
+            key_type k{idx, ++slot.generation};
+            T& obj = slot.object.emplace(
+                        detail::forward_arg_or_key<Args>(
+                            std::forward<Args>(args), k)...);
+
+            this->statistics_policy().on_emplace_in_free_slot();
+            return {k, obj};
+        }
+    }
+
+    void remove(key_type const &k) {
+        bool const present = is_present(k);
+        this->statistics_policy().on_remove(present);
+
+        if(present) {
+            auto& slot = slots[k.get_index()];
+            ++slot.generation;
+            slot.object.erase();
+            free_indexes.push_back(k.get_index());
+        }
+    }
+
+private:
+    void destroy_live_objects() {
+        if constexpr (!std::is_trivially_destructible_v<T>) {
+            for(auto& slot : slots) {
+                if(detail::is_valid(slot.generation)) {
+                    slot.object.erase();
+                }
+            }
+        }
+    }
+
+    // Same as split_gic: the slots container never grows by itself, only the
+    // living objects are moved, all at once if they are trivially relocatable.
+    void grow_slots() {
+        slot_container grown;
+        grown.reserve(slots.empty() ? 1 : slots.size() * 2);
+        auto const size = slots.size();
+
+        if constexpr (is_trivially_relocatable_v<T>) {
+            grown.resize(size);
+            if(size != 0) {
+                std::memcpy(static_cast<void*>(grown.data()),
+                            static_cast<void const*>(slots.data()),
+                            size * sizeof(slot_type));
+            }
+        }
+        else {
+            try {
+                for(auto& slot : slots) {
+                    if(detail::is_valid(slot.generation)) {
+                        grown.emplace_back(slot.generation,
+                                           std::in_place,
+                                           std::move_if_noexcept(*slot.object));
+                    }
+                    else {
+                        grown.emplace_back(slot.generation);
+                    }
+                }
+            }
+            catch(...) {
+                grown.swap(slots);
+                destroy_live_objects();
+                grown.swap(slots);
+                throw;
+            }
+
+            destroy_live_objects();
+        }
+
+        slots.swap(grown);
+    }
+};
+
+} // end namespace genex
+
+#endif // INTERLEAVED_GIC_HPP
@@ -0,0 +1,389 @@
+#ifndef JOURNALED_GIC_HPP
+#define JOURNALED_GIC_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <istream>
+#include <limits>
+#include <ostream>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <boost/optional.hpp>
+
+#include "detail/key_placeholding.hpp"
+
+namespace genex {
+
+// How a journaled_gic writes elements to its journal and reads them back. The
+// default one copies the bytes of trivially copyable objects; other objects
+// need a codec of the same shape.
+template<typename T>
+struct trivial_codec {
+    static_assert(std::is_trivially_copyable_v<T>,
+                  "objects that are not trivially copyable need a codec");
+
+    void encode(T const& object, std::vector<char>& out) const {
+        auto const* bytes = reinterpret_cast<char const*>(&object);
+        out.insert(out.end(), bytes, bytes + sizeof(T));
+    }
+
+    T decode(char const* data, std::size_t size) const {
+        if(size != sizeof(T)) {
+            throw std::runtime_error("journal record of the wrong size");
+        }
+        T object;
+        std::memcpy(&object, data, sizeof(T));
+        return object;
+    }
+};
+
+namespace detail {
+
+enum class journal_operation : std::uint8_t {
+    emplace = 1,
+    remove = 2,
+    update = 3
+};
+
+// Each record is the operation, the index and generation of its key and the
+// size of the encoded element, followed by the encoded element, if any. Fields
+// are written in the byte order of the machine.
+template<class Key>
+struct journal_record_header {
+    using index_type = typename Key::index_type;
+    using generation_type = typename Key::generation_type;
+
+    static constexpr std::size_t size =
+        1 + sizeof(index_type) + sizeof(generation_type) +
+        sizeof(std::uint32_t);
+
+    journal_operation operation;
+    Key k;
+    std::uint32_t payload_size;
+
+    void write(char* data) const {
+        auto const op = static_cast<std::uint8_t>(operation);
+        auto const idx = k.get_index();
+        auto const generation = k.get_generation();
+        data = put(data, op);
+        data = put(data, idx);
+        data = put(data, generation);
+        put(data, payload_size);
+    }
+
+    static journal_record_header read(char const* data) {
+        std::uint8_t op;
+        index_type idx;
+        generation_type generation;
+        std::uint32_t payload;
+        data = extract(data, op);
+        data = extract(data, idx);
+        data = extract(data, generation);
+        extract(data, payload);
+        return {static_cast<journal_operation>(op), Key{idx, generation},
+                payload};
+    }
+
+private:
+    template<typename V>
+    static char* put(char* data, V const& value) {
+        std::memcpy(data, &value, sizeof(V));
+        return data + sizeof(V);
+    }
+
+    template<typename V>
+    static char const* extract(char const* data, V& value) {
+        std::memcpy(&value, data, sizeof(V));
+        return data + sizeof(V);
+    }
+};
+
+} // end namespace detail
+
+// A genex container that appends a record of each of its modifications to a
+// journal, so that replaying the journal on the state the container started
+// from, e.g. empty or a snapshot, rebuilds the same elements under the same
+// keys: emplacing is deterministic. A snapshot taken by copying container()
+// reuses free slots in the same order, so the rest of the journal can be
+// replayed on it.
+//
+// Emplacements are recorded with the element they constructed, which is what
+// gets emplaced again on replay. Elements are only handed out as const, except
+// through modify(), which records their new value.
+//
+// Elements are encoded before the container is modified, so that it stays in
+// the state the journal describes if encoding throws: emplace() constructs the
+// element, encodes it, then emplaces it by move, and modify() calls f on a
+// copy of the element, encodes it, then moves it into the element.
+//
+// Records are buffered and written to the stream once the buffer is full, or
+// by flush(). Whether they are durable then is up to the stream.
+template<class Gic, class Codec = trivial_codec<typename Gic::value_type>>
+class journaled_gic {
+public:
+    using container_type = Gic;
+    using value_type = typename Gic::value_type;
+    using key_type = typename Gic::key_type;
+    using element_const_access_type = boost::optional<value_type const&>;
+
+    static constexpr std::size_t default_buffer_size = std::size_t{64} << 10;
+
+    explicit journaled_gic(std::ostream& journal,
+                           Gic initial = Gic{},
+                           Codec codec = Codec{},
+                           std::size_t buffer_size = default_buffer_size)
+        : journal(journal),
+          gic(std::move(initial)),
+          codec(std::move(codec)),
+          buffer_size(buffer_size)
+    {
+        buffer.reserve(buffer_size);
+    }
+
+    journaled_gic(journaled_gic const&) = delete;
+    journaled_gic& operator=(journaled_gic const&) = delete;
+
+    // Errors of the stream cannot be reported from here: flush() beforehand
+    // to know about them.
+    ~journaled_gic() {
+        try {
+            flush();
+        }
+        catch(...) {}
+    }
+
+    template<typename... Args>
+    [[nodiscard]] key_type emplace(Args&&... args) {
+        return std::get<0>(emplace_and_get(std::forward<Args>(args)...));
+    }
+
+    template<typename... Args>
+    [[nodiscard]] std::pair<key_type, value_type const&>
+    emplace_and_get(Args&&... args) {
+        static_assert(!detail::has_key_placeholder_v<Args...>,
+                      "journaled_gic does not support key placeholders");
+
+        value_type object(std::forward<Args>(args)...);
+        auto const start = encode_record(&object);
+        auto emplaced = drop_record_if_throws(start, [&] {
+            return gic.emplace_and_get(std::move(object));
+        });
+        complete_record(start, detail::journal_operation::emplace,
+                        emplaced.first);
+        return {emplaced.first, emplaced.second};
+    }
+
+    void remove(key_type const& k) {
+        if(gic.is_present(k)) {
+            auto const start = encode_record(nullptr);
+            drop_record_if_throws(start, [&] { gic.remove(k); });
+            complete_record(start, detail::journal_operation::remove, k);
+        }
+    }
+
+    // Calls f with a copy of the element of k, if present, records it and
+    // moves it into the element. Returns whether it was present.
+    template<typename F>
+    bool modify(key_type const& k, F&& f) {
+        auto* object = gic.get_ptr(k);
+        if(object == nullptr) {
+            return false;
+        }
+
+        value_type updated = *object;
+        std::invoke(std::forward<F>(f), updated);
+        auto const start = encode_record(&updated);
+        drop_record_if_throws(start, [&] { *object = std::move(updated); });
+        complete_record(start, detail::journal_operation::update, k);
+        return true;
+    }
+
+    [[nodiscard]] bool is_present(key_type const& k) const {
+        return gic.is_present(k);
+    }
+
+    [[nodiscard]] value_type const* get_ptr(key_type const& k) const {
+        return gic.get_ptr(k);
+    }
+
+    [[nodiscard]] element_const_access_type get(key_type const& k) const {
+        return gic.get(k);
+    }
+
+    [[nodiscard]] element_const_access_type
+    operator[](key_type const& k) const {
+        return get(k);
+    }
+
+    [[nodiscard]] Gic const& container() const noexcept {
+        return gic;
+    }
+
+    auto begin() const {
+        return gic.cbegin();
+    }
+
+    auto end() const {
+        return gic.cend();
+    }
+
+    auto cbegin() const {
+        return gic.cbegin();
+    }
+
+    auto cend() const {
+        return gic.cend();
+    }
+
+    // Writes the buffered records to the stream and flushes it. Throws
+    // std::runtime_error if the stream failed.
+    void flush() {
+        write_buffer();
+        journal.flush();
+        if(!journal) {
+            throw std::runtime_error("could not write the journal");
+        }
+    }
+
+    // Applies the records of journal to container, which must be in the state
+    // the journaled container started from. Stops at the end of the journal,
+    // or at a record cut short, as the last one may be after a crash. Returns
+    // how many records were applied.
+    //
+    // Throws std::runtime_error if a record does not fit the container, e.g.
+    // if it started from another state.
+    static std::size_t replay(std::istream& journal,
+                              Gic& container,
+                              Codec const& codec = Codec{})
+    {
+        using header_type = detail::journal_record_header<key_type>;
+
+        std::size_t applied = 0;
+        char header_bytes[header_type::size];
+        std::vector<char> payload;
+
+        while(journal.read(header_bytes, header_type::size)) {
+            auto const header = header_type::read(header_bytes);
+            payload.resize(header.payload_size);
+            if(!journal.read(payload.data(),
+                             static_cast<std::streamsize>(payload.size()))) {
+                break;
+            }
+
+            apply(container, codec, header, payload);
+            ++applied;
+        }
+
+        return applied;
+    }
+
+private:
+    using header_type = detail::journal_record_header<key_type>;
+
+    std::ostream& journal;
+    Gic gic;
+    Codec codec;
+    std::size_t buffer_size;
+    std::vector<char> buffer;
+
+    // Starts a record with room for its header, followed by the encoded
+    // object, if any, and returns where it starts. If encoding throws, the
+    // buffer is left as it was.
+    std::size_t encode_record(value_type const* object) {
+        auto const start = buffer.size();
+        buffer.resize(start + header_type::size);
+        if(object != nullptr) {
+            try {
+                codec.encode(*object, buffer);
+            }
+            catch(...) {
+                buffer.resize(start);
+                throw;
+            }
+
+            auto const payload = buffer.size() - start - header_type::size;
+            if(payload > std::numeric_limits<std::uint32_t>::max()) {
+                buffer.resize(start);
+                throw std::length_error("element too big for the journal");
+            }
+        }
+        return start;
+    }
+
+    // Calls change, which modifies the container, and drops the record
+    // started at start if it throws.
+    template<typename F>
+    decltype(auto) drop_record_if_throws(std::size_t start, F&& change) {
+        try {
+            return change();
+        }
+        catch(...) {
+            buffer.resize(start);
+            throw;
+        }
+    }
+
+    // Writes the header of the record started at start, once the container
+    // was modified.
+    void complete_record(std::size_t start,
+                         detail::journal_operation operation,
+                         key_type const& k)
+    {
+        auto const payload = buffer.size() - start - header_type::size;
+        header_type{operation, k, static_cast<std::uint32_t>(payload)}
+            .write(buffer.data() + start);
+
+        if(buffer.size() >= buffer_size) {
+            write_buffer();
+        }
+    }
+
+    void write_buffer() {
+        journal.write(buffer.data(),
+                      static_cast<std::streamsize>(buffer.size()));
+        buffer.clear();
+    }
+
+    static void apply(Gic& container,
+                      Codec const& codec,
+                      header_type const& header,
+                      std::vector<char> const& payload)
+    {
+        switch(header.operation) {
+        case detail::journal_operation::emplace: {
+            auto k = container.emplace(codec.decode(payload.data(),
+                                                    payload.size()));
+            if(!(k == header.k)) {
+                throw std::runtime_error(
+                    "journal replayed on another state of the container");
+            }
+            return;
+        }
+        case detail::journal_operation::remove:
+            if(!container.is_present(header.k)) {
+                throw std::runtime_error("journal removes a missing key");
+            }
+            container.remove(header.k);
+            return;
+        case detail::journal_operation::update: {
+            auto* object = container.get_ptr(header.k);
+            if(object == nullptr) {
+                throw std::runtime_error("journal updates a missing key");
+            }
+            *object = codec.decode(payload.data(), payload.size());
+            return;
+        }
+        }
+
+        throw std::runtime_error("unknown journal record");
+    }
+};
+
+} // end namespace genex
+
+#endif // JOURNALED_GIC_HPP
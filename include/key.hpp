@@ -76,29 +76,29 @@ public:
     using generation_type = Generation;
     using tag_type = Tag;
 
-    key(Index&& index, Generation&& gen) :
+    constexpr key(Index&& index, Generation&& gen) :
         index(std::forward<Index>(index)),
         generation(std::forward<Generation>(gen))
     {}
 
-    key(Index const & index, Generation const & gen) :
+    constexpr key(Index const & index, Generation const & gen) :
         index(index),
         generation(gen)
     {}
 
-    Generation const & get_generation() const {
+    constexpr Generation const & get_generation() const {
         return generation;
     }
 
-    Index const & get_index() const {
+    constexpr Index const & get_index() const {
         return index;
     }
 
-    bool operator==(key const& other) const {
+    constexpr bool operator==(key const& other) const {
         return (generation == other.generation) && (index == other.index);
     }
 
-    bool operator!=(key const& other) const {
+    constexpr bool operator!=(key const& other) const {
         return !(*this == other);
     }
 
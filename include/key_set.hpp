@@ -0,0 +1,284 @@
+#ifndef KEY_SET_HPP
+#define KEY_SET_HPP
+
+#include <cstddef>
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+#include <boost/iterator/iterator_facade.hpp>
+
+#include "key.hpp"
+#include "detail/bits.hpp"
+#include "detail/iterator_utils.hpp"
+
+namespace genex {
+
+// A set of keys of another genex container, which owns the key space, such as
+// the selected or the visible elements. Membership is one bit per index, so
+// that union, intersection and difference work a word of 64 indexes at a
+// time, and the generation of each key is kept next to it, as in
+// secondary_map, so that keys of removed elements are rejected once the owner
+// reuses their slot.
+//
+// Keys of elements removed from the owning container stay in the set until
+// they are erased from it or replaced by the key of the new occupant of their
+// slot. for_each_in skips them, erase_stale drops them.
+//
+// Union, intersection and difference combine the words only, that is the
+// indexes: generations are checked where keys are read back, by contains()
+// and for_each_in. Where both sets hold a key of the same index but of
+// another generation, one of them is stale and they are combined as if they
+// were the same key. erase_stale on both sets first gives the operations on
+// the keys of present elements only.
+template<class Key>
+class key_set {
+public:
+    using key_type = Key;
+    using value_type = Key;
+    using index_type = typename key_type::index_type;
+    using generation_type = typename key_type::generation_type;
+
+    class iterator;
+    using const_iterator = iterator;
+
+    key_set() = default;
+
+    void swap(key_set& other) noexcept {
+        using std::swap;
+        swap(words, other.words);
+        swap(generations, other.generations);
+    }
+
+    friend void swap(key_set& a, key_set& b) noexcept {
+        a.swap(b);
+    }
+
+    // Adds k, replacing an older key of the same index. Returns whether k was
+    // not in the set already.
+    bool insert(key_type const& k) {
+        auto const idx = static_cast<std::size_t>(k.get_index());
+        if(idx >= generations.size()) {
+            auto const word_count = idx / detail::bits_per_word + 1;
+            words.resize(word_count, 0);
+            generations.resize(word_count * detail::bits_per_word);
+        }
+
+        bool const inserted = !contains(k);
+        words[idx / detail::bits_per_word] |= bit_of(idx);
+        generations[idx] = k.get_generation();
+        return inserted;
+    }
+
+    [[nodiscard]] bool contains(key_type const& k) const noexcept {
+        auto const idx = static_cast<std::size_t>(k.get_index());
+        return idx < generations.size() &&
+               (words[idx / detail::bits_per_word] & bit_of(idx)) != 0 &&
+               generations[idx] == k.get_generation();
+    }
+
+    void erase(key_type const& k) noexcept {
+        if(contains(k)) {
+            auto const idx = static_cast<std::size_t>(k.get_index());
+            words[idx / detail::bits_per_word] &= ~bit_of(idx);
+        }
+    }
+
+    void clear() noexcept {
+        std::fill(words.begin(), words.end(), 0);
+    }
+
+    [[nodiscard]] bool empty() const noexcept {
+        return std::all_of(words.begin(), words.end(),
+                           [](auto word) { return word == 0; });
+    }
+
+    // Counts the bits, in time proportional to the highest index inserted.
+    [[nodiscard]] std::size_t size() const noexcept {
+        std::size_t count = 0;
+        for(auto word : words) {
+            count += detail::count_set_bits(word);
+        }
+        return count;
+    }
+
+    // Where both sets hold a key of the same index, the key of other is kept.
+    key_set& operator|=(key_set const& other) {
+        if(other.words.size() > words.size()) {
+            words.resize(other.words.size(), 0);
+            generations.resize(other.generations.size());
+        }
+
+        for(std::size_t w = 0; w < other.words.size(); ++w) {
+            for_each_index(other.words[w], w, [&](std::size_t idx) {
+                generations[idx] = other.generations[idx];
+            });
+            words[w] |= other.words[w];
+        }
+        return *this;
+    }
+
+    key_set& operator&=(key_set const& other) noexcept {
+        auto const common = std::min(words.size(), other.words.size());
+        for(std::size_t w = 0; w < common; ++w) {
+            words[w] &= other.words[w];
+        }
+        std::fill(words.begin() + common, words.end(), 0);
+        return *this;
+    }
+
+    key_set& operator-=(key_set const& other) noexcept {
+        auto const common = std::min(words.size(), other.words.size());
+        for(std::size_t w = 0; w < common; ++w) {
+            words[w] &= ~other.words[w];
+        }
+        return *this;
+    }
+
+    friend key_set operator|(key_set a, key_set const& b) {
+        return a |= b;
+    }
+
+    friend key_set operator&(key_set a, key_set const& b) {
+        return a &= b;
+    }
+
+    friend key_set operator-(key_set a, key_set const& b) {
+        return a -= b;
+    }
+
+    // Calls f with the element of each key of the set that is present in
+    // owner.
+    template<class Container, typename F>
+    void for_each_in(Container& owner, F&& f) const {
+        for(auto const& k : *this) {
+            if(auto* element = owner.get_ptr(k)) {
+                f(*element);
+            }
+        }
+    }
+
+    // Erases the keys that are not present in owner anymore.
+    template<class Container>
+    void erase_stale(Container const& owner) {
+        for(std::size_t w = 0; w < words.size(); ++w) {
+            for_each_index(words[w], w, [&](std::size_t idx) {
+                if(!owner.is_present(key_at(idx))) {
+                    words[w] &= ~bit_of(idx);
+                }
+            });
+        }
+    }
+
+    // Yields the keys in the order of their indexes.
+    iterator begin() const noexcept {
+        return {*this, 0};
+    }
+
+    iterator end() const noexcept {
+        return {*this, words.size()};
+    }
+
+    iterator cbegin() const noexcept {
+        return begin();
+    }
+
+    iterator cend() const noexcept {
+        return end();
+    }
+
+private:
+    using bit_word = detail::bit_word;
+
+    std::vector<bit_word> words;
+    std::vector<generation_type> generations;
+
+    static bit_word bit_of(std::size_t idx) noexcept {
+        return bit_word{1} << (idx % detail::bits_per_word);
+    }
+
+    key_type key_at(std::size_t idx) const noexcept {
+        return {static_cast<index_type>(idx), generations[idx]};
+    }
+
+    template<typename F>
+    static void for_each_index(bit_word word, std::size_t w, F&& f) {
+        detail::for_each_set_bit(word, [&](std::size_t bit) {
+            f(w * detail::bits_per_word + bit);
+        });
+    }
+};
+
+template<class Key>
+class key_set<Key>::iterator :
+        public boost::iterator_facade<iterator,
+                                      Key,
+                                      boost::forward_traversal_tag,
+                                      Key>
+{
+public:
+    iterator() = default;
+
+    friend bool operator==(iterator const& it, end_sentinel_t) {
+        return it.at_end();
+    }
+
+    friend bool operator==(end_sentinel_t, iterator const& it) {
+        return it.at_end();
+    }
+
+    friend bool operator!=(iterator const& it, end_sentinel_t) {
+        return !it.at_end();
+    }
+
+    friend bool operator!=(end_sentinel_t, iterator const& it) {
+        return !it.at_end();
+    }
+
+private:
+    friend class boost::iterator_core_access;
+    friend class key_set;
+
+    // The bits of the current word that are still to be visited, the
+    // current one being the lowest.
+    key_set const* set = nullptr;
+    std::size_t word = 0;
+    bit_word remaining = 0;
+
+    iterator(key_set const& s, std::size_t w) noexcept : set(&s), word(w) {
+        if(word < set->words.size()) {
+            remaining = set->words[word];
+            skip_empty_words();
+        }
+    }
+
+    bool at_end() const noexcept {
+        return set == nullptr || word >= set->words.size();
+    }
+
+    Key dereference() const noexcept {
+        return set->key_at(word * detail::bits_per_word +
+                           detail::lowest_set_bit(remaining));
+    }
+
+    bool equal(iterator const& other) const noexcept {
+        return word == other.word && remaining == other.remaining;
+    }
+
+    void increment() noexcept {
+        if(!at_end()) {
+            remaining &= remaining - 1;
+            skip_empty_words();
+        }
+    }
+
+    void skip_empty_words() noexcept {
+        while(remaining == 0 && ++word < set->words.size()) {
+            remaining = set->words[word];
+        }
+    }
+};
+
+} // end namespace genex
+
+#endif // KEY_SET_HPP
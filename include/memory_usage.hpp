@@ -0,0 +1,89 @@
+#ifndef GIC_MEMORY_USAGE_HPP
+#define GIC_MEMORY_USAGE_HPP
+
+#include <cstddef>
+#include <limits>
+
+#include "detail/element_validity_embedded_in_generation.hpp"
+
+namespace genex {
+
+// Bytes taken by one of the containers a genex container is made of: its
+// capacity versus its size, times the size of an element.
+struct container_memory {
+    std::size_t allocated_bytes = 0;
+    std::size_t used_bytes = 0;
+};
+
+// What a genex container costs, as returned by its memory_usage() member
+// function. Containers that have no such part, e.g. the free indexes of
+// gic_fit which live in the free slots, report it as zero bytes.
+struct gic_memory_usage {
+    container_memory objects;
+    container_memory generations;
+    container_memory free_indexes;
+
+    std::size_t live_slots = 0;
+    std::size_t free_slots = 0;
+    // largest number of consecutive free slots
+    std::size_t longest_free_run = 0;
+
+    std::size_t allocated_bytes() const noexcept {
+        return objects.allocated_bytes +
+               generations.allocated_bytes +
+               free_indexes.allocated_bytes;
+    }
+
+    std::size_t used_bytes() const noexcept {
+        return objects.used_bytes +
+               generations.used_bytes +
+               free_indexes.used_bytes;
+    }
+
+    // Free slots per living element: 0 without any hole, infinite when every
+    // slot is a hole.
+    double holes_per_live_slot() const noexcept {
+        if(live_slots == 0) {
+            return free_slots == 0 ?
+                0.0 : std::numeric_limits<double>::infinity();
+        }
+
+        return static_cast<double>(free_slots) /
+               static_cast<double>(live_slots);
+    }
+};
+
+namespace detail {
+
+template<class Container>
+container_memory memory_of(Container const& container) noexcept {
+    constexpr auto element_size = sizeof(typename Container::value_type);
+    return {container.capacity() * element_size,
+            container.size() * element_size};
+}
+
+// Fills the slot counts of usage from the generations of the slots.
+template<class GenerationContainer>
+void count_slots(GenerationContainer const& generations,
+                 gic_memory_usage& usage) noexcept
+{
+    std::size_t free_run = 0;
+    for(auto const& generation : generations) {
+        if(is_valid(generation)) {
+            ++usage.live_slots;
+            free_run = 0;
+        }
+        else {
+            ++usage.free_slots;
+            if(++free_run > usage.longest_free_run) {
+                usage.longest_free_run = free_run;
+            }
+        }
+    }
+}
+
+} // end namespace detail
+
+} // end namespace genex
+
+#endif // GIC_MEMORY_USAGE_HPP
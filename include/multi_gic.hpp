@@ -0,0 +1,224 @@
+#ifndef MULTI_GIC_HPP
+#define MULTI_GIC_HPP
+
+#include <cstddef>
+#include <tuple>
+#include <utility>
+#include <type_traits>
+
+#include <boost/optional.hpp>
+
+#include "key.hpp"
+#include "split_gic.hpp"
+#include "detail/key_placeholding.hpp"
+
+namespace genex {
+
+namespace detail {
+
+template<typename T, typename... Ts>
+constexpr std::size_t type_index() {
+    static_assert((std::is_same_v<T, Ts> || ...),
+                  "the type is not one of the types of the container");
+
+    constexpr bool matches[] = {std::is_same_v<T, Ts>...};
+    std::size_t idx = 0;
+    while(!matches[idx]) {
+        ++idx;
+    }
+    return idx;
+}
+
+template<typename T, typename... Ts>
+constexpr std::size_t occurrences = (std::size_t{std::is_same_v<T, Ts>} + ...);
+
+} // end namespace detail
+
+// One split_gic per type of Ts, whose keys share a single key type. A key
+// tells which pool its element lives in, so that an element of any type can
+// be looked up or visited with no virtual call, and each type is iterated
+// over in its own contiguous storage.
+//
+// As in sharded_gic, the index of a key is local_index * sizeof...(Ts) +
+// type_index, and objects cannot be given their key through key_placeholder.
+template<typename... Ts>
+class multi_gic {
+    static_assert(sizeof...(Ts) != 0, "a multi_gic needs at least one type");
+    static_assert(((detail::occurrences<Ts, Ts...> == 1) && ...),
+                  "the types of a multi_gic must be different");
+
+public:
+    using key_type = key<multi_gic>;
+    using index_type = typename key_type::index_type;
+    using generation_type = typename key_type::generation_type;
+
+    template<typename T>
+    using pool_type = split_gic<T>;
+
+    static constexpr std::size_t type_count = sizeof...(Ts);
+
+    template<typename T>
+    static constexpr std::size_t type_index = detail::type_index<T, Ts...>();
+
+    [[nodiscard]] static constexpr std::size_t
+    type_of(key_type const& k) noexcept {
+        return static_cast<std::size_t>(k.get_index() % type_count);
+    }
+
+    template<typename T>
+    [[nodiscard]] static constexpr bool holds(key_type const& k) noexcept {
+        return type_of(k) == type_index<T>;
+    }
+
+    // ===== Per type =====
+
+    template<typename T, typename... Args>
+    [[nodiscard]] key_type emplace(Args&&... args) {
+        return std::get<0>(
+            emplace_and_get<T>(std::forward<Args>(args)...));
+    }
+
+    template<typename T, typename... Args>
+    [[nodiscard]] std::pair<key_type, T&> emplace_and_get(Args&&... args) {
+        static_assert(!detail::has_key_placeholder_v<Args...>,
+                      "multi_gic does not support key placeholders");
+
+        auto [local_key, obj] =
+            pool<T>().emplace_and_get(std::forward<Args>(args)...);
+        return {to_global<T>(local_key), obj};
+    }
+
+    template<typename T>
+    [[nodiscard]] T* get_ptr(key_type const& k) {
+        return holds<T>(k) ? pool<T>().get_ptr(to_local<T>(k)) : nullptr;
+    }
+
+    template<typename T>
+    [[nodiscard]] T const* get_ptr(key_type const& k) const {
+        return holds<T>(k) ? pool<T>().get_ptr(to_local<T>(k)) : nullptr;
+    }
+
+    template<typename T>
+    [[nodiscard]] boost::optional<T&> get(key_type const& k) {
+        return holds<T>(k) ?
+            pool<T>().get(to_local<T>(k)) : boost::optional<T&>{};
+    }
+
+    template<typename T>
+    [[nodiscard]] boost::optional<T const&> get(key_type const& k) const {
+        return holds<T>(k) ?
+            pool<T>().get(to_local<T>(k)) : boost::optional<T const&>{};
+    }
+
+    template<typename T>
+    [[nodiscard]] pool_type<T>& pool() noexcept {
+        return std::get<type_index<T>>(pools);
+    }
+
+    template<typename T>
+    [[nodiscard]] pool_type<T> const& pool() const noexcept {
+        return std::get<type_index<T>>(pools);
+    }
+
+    // ===== Any type, dispatched on the type of the key =====
+
+    [[nodiscard]] bool is_present(key_type const& k) const {
+        return visit(k, [](auto const&) {});
+    }
+
+    void remove(key_type const& k) {
+        dispatch(k, [&](auto& p, auto const& local) {
+            p.remove(local);
+            return true;
+        });
+    }
+
+    // Calls f with the element of k, if present. Returns whether it was.
+    template<typename F>
+    bool visit(key_type const& k, F&& f) {
+        return dispatch(k, [&](auto& p, auto const& local) {
+            return p.visit(local, f);
+        });
+    }
+
+    template<typename F>
+    bool visit(key_type const& k, F&& f) const {
+        return dispatch(k, [&](auto const& p, auto const& local) {
+            return p.visit(local, f);
+        });
+    }
+
+    // Calls f with every element, one type after the other.
+    template<typename F>
+    void for_each(F&& f) {
+        std::apply([&](auto&... p) {
+            (for_each_in(p, f), ...);
+        }, pools);
+    }
+
+    template<typename F>
+    void for_each(F&& f) const {
+        std::apply([&](auto const&... p) {
+            (for_each_in(p, f), ...);
+        }, pools);
+    }
+
+private:
+    std::tuple<pool_type<Ts>...> pools;
+
+    template<typename T>
+    static key_type to_global(typename pool_type<T>::key_type const& local) {
+        return {static_cast<index_type>(local.get_index() * type_count +
+                                        type_index<T>),
+                local.get_generation()};
+    }
+
+    template<typename T>
+    static typename pool_type<T>::key_type to_local(key_type const& global) {
+        return {static_cast<index_type>(global.get_index() / type_count),
+                global.get_generation()};
+    }
+
+    // Calls f(pool, local_key) on the pool of the type of k, with the key
+    // translated to the key type of that pool.
+    template<typename Self, typename F>
+    static bool dispatch_in(Self& self, key_type const& k, F&& f) {
+        return dispatch_in(self, k, f, std::index_sequence_for<Ts...>{});
+    }
+
+    template<typename Self, typename F, std::size_t... Is>
+    static bool dispatch_in(Self& self,
+                            key_type const& k,
+                            F& f,
+                            std::index_sequence<Is...>)
+    {
+        auto const type = type_of(k);
+        bool result = false;
+        ((type == Is ?
+             (result = f(std::get<Is>(self.pools),
+                         to_local<Ts>(k)), true) :
+             false) || ...);
+        return result;
+    }
+
+    template<typename F>
+    bool dispatch(key_type const& k, F&& f) {
+        return dispatch_in(*this, k, f);
+    }
+
+    template<typename F>
+    bool dispatch(key_type const& k, F&& f) const {
+        return dispatch_in(*this, k, f);
+    }
+
+    template<typename Pool, typename F>
+    static void for_each_in(Pool& p, F& f) {
+        for(auto& element : p) {
+            f(element);
+        }
+    }
+};
+
+} // end namespace genex
+
+#endif // MULTI_GIC_HPP
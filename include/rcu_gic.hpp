@@ -0,0 +1,194 @@
+#ifndef RCU_GIC_HPP
+#define RCU_GIC_HPP
+
+#include <cstddef>
+#include <memory>
+#include <atomic>
+#include <utility>
+#include <type_traits>
+
+#include "statistics.hpp"
+
+namespace genex {
+
+namespace detail {
+
+// Whether Gic can be brought to a later state of a copy of it with
+// delta_from and apply_delta, like split_gic.
+template<class Gic, class = void>
+struct has_delta : std::false_type {};
+
+template<class Gic>
+struct has_delta<Gic, std::void_t<decltype(
+    std::declval<Gic&>().apply_delta(
+        std::declval<Gic const&>().delta_from(std::declval<Gic const&>())))>>
+    : std::true_type {};
+
+} // end namespace detail
+
+// Read-copy-update around a genex container: one writer thread modifies the
+// container while any number of reader threads look at immutable snapshots of
+// it, without locking each other out for longer than a shared_ptr copy.
+//
+// The writer works on its own container and calls publish() whenever readers
+// should see its current state, typically once per tick. A snapshot is
+// reclaimed when the last reader holding it lets it go, which is how readers
+// of an old epoch keep it alive while the writer moves on.
+//
+// publish() recycles the version it replaced last time once no reader holds
+// it anymore, which is the common case when readers only hold snapshots for a
+// tick. If Gic has delta_from and apply_delta, e.g. split_gic, that version is
+// brought up to date by copying only the elements that changed since, which
+// still compares every slot but allocates nothing as long as the container
+// does not grow. Otherwise, or when a reader still holds it, the whole
+// container is copied.
+//
+// Readers share the snapshots, so Gic must not count statistics on reads,
+// which are not thread-safe.
+template<class Gic>
+class rcu_gic {
+    static_assert(std::is_same_v<typename Gic::statistics_type, no_statistics>,
+                  "snapshots are read from several threads at once");
+
+public:
+    using container_type = Gic;
+    using key_type = typename Gic::key_type;
+    using value_type = typename Gic::value_type;
+
+private:
+    struct version {
+        Gic state;
+        std::size_t epoch;
+    };
+
+public:
+    // Immutable view of the container as of one call to publish().
+    class snapshot {
+    public:
+        [[nodiscard]] decltype(auto) get(key_type const& k) const {
+            return published->state.get(k);
+        }
+
+        [[nodiscard]] decltype(auto) operator[](key_type const& k) const {
+            return published->state[k];
+        }
+
+        [[nodiscard]] value_type const* get_ptr(key_type const& k) const {
+            return published->state.get_ptr(k);
+        }
+
+        [[nodiscard]] bool is_present(key_type const& k) const {
+            return published->state.is_present(k);
+        }
+
+        decltype(auto) begin() const {
+            return published->state.cbegin();
+        }
+
+        decltype(auto) end() const {
+            return published->state.cend();
+        }
+
+        Gic const& operator*() const noexcept {
+            return published->state;
+        }
+
+        Gic const* operator->() const noexcept {
+            return std::addressof(published->state);
+        }
+
+        // number of calls to publish() that preceded this snapshot
+        std::size_t epoch() const noexcept {
+            return published->epoch;
+        }
+
+    private:
+        friend class rcu_gic;
+
+        explicit snapshot(std::shared_ptr<version const> v)
+            : published(std::move(v))
+        {}
+
+        std::shared_ptr<version const> published;
+    };
+
+    rcu_gic() : rcu_gic(Gic{}) {}
+
+    explicit rcu_gic(Gic initial)
+        : current(std::move(initial)),
+          latest(std::make_shared<version>(version{current, 0})),
+          published(latest)
+    {}
+
+    rcu_gic(rcu_gic const&) = delete;
+    rcu_gic& operator=(rcu_gic const&) = delete;
+
+    // ===== Writer side, from a single thread =====
+
+    Gic& writer() noexcept {
+        return current;
+    }
+
+    Gic const& writer() const noexcept {
+        return current;
+    }
+
+    // Makes the current state of the writer's container visible to the
+    // snapshots taken from now on. Returns the epoch of that state.
+    //
+    // O(n): updates or copies a version of the container, see above, then
+    // swaps the published version.
+    std::size_t publish() {
+        std::shared_ptr<version> next = take_retired();
+        if(next) {
+            if constexpr (detail::has_delta<Gic>::value) {
+                next->state.apply_delta(current.delta_from(next->state));
+            }
+            else {
+                next->state = current;
+            }
+            next->epoch = ++epoch;
+        }
+        else {
+            next = std::make_shared<version>(version{current, ++epoch});
+        }
+
+        retired = std::exchange(latest, std::move(next));
+        std::atomic_store_explicit(&published,
+                                   std::shared_ptr<version const>(latest),
+                                   std::memory_order_release);
+        return epoch;
+    }
+
+    // ===== Reader side, from any thread =====
+
+    [[nodiscard]] snapshot read() const {
+        return snapshot{std::atomic_load_explicit(&published,
+                                                  std::memory_order_acquire)};
+    }
+
+private:
+    Gic current;
+    std::size_t epoch{0};
+    // the published version, and the one it replaced, which publish()
+    // recycles once no reader holds it
+    std::shared_ptr<version> latest;
+    std::shared_ptr<version> retired;
+    std::shared_ptr<version const> published;
+
+    // The retired version if no reader holds it anymore. Readers only get
+    // the published version, so none can take it again.
+    std::shared_ptr<version> take_retired() {
+        if(!retired || retired.use_count() != 1) {
+            return nullptr;
+        }
+        // pairs with the release of the readers dropping their snapshots, so
+        // that their reads happen before the writer modifies the version
+        std::atomic_thread_fence(std::memory_order_acquire);
+        return std::move(retired);
+    }
+};
+
+} // end namespace genex
+
+#endif // RCU_GIC_HPP
@@ -0,0 +1,24 @@
+#ifndef GENEX_RELOCATION_HPP
+#define GENEX_RELOCATION_HPP
+
+#include <type_traits>
+
+namespace genex {
+
+// Whether an object of type T can be moved to another address by copying its
+// bytes, the original bytes being discarded without calling the destructor.
+// genex containers then grow with memcpy instead of moving each object.
+//
+// This is true of trivially copyable types, and of most types that do not
+// point into themselves. Specialize it for the latter, e.g.:
+//     template<> struct genex::is_trivially_relocatable<my_type>
+//         : std::true_type {};
+template<typename T>
+struct is_trivially_relocatable : std::is_trivially_copyable<T> {};
+
+template<typename T>
+constexpr bool is_trivially_relocatable_v = is_trivially_relocatable<T>::value;
+
+} // end namespace genex
+
+#endif // GENEX_RELOCATION_HPP
@@ -0,0 +1,233 @@
+#ifndef SECONDARY_MAP_HPP
+#define SECONDARY_MAP_HPP
+
+#include <cstddef>
+#include <algorithm>
+#include <utility>
+#include <vector>
+#include <type_traits>
+
+#include <boost/optional.hpp>
+
+#include "key.hpp"
+#include "detail/manually_destructed.hpp"
+#include "detail/live_objects.hpp"
+#include "detail/element_validity_embedded_in_generation.hpp"
+#include "detail/split_gic_iterator.hpp"
+#include "detail/iterator_utils.hpp"
+#include "detail/perfect_backward.hpp"
+
+namespace genex {
+
+// Associates values to the keys of another genex container, which owns the key
+// space. Values are stored at the index of their key, like the objects of a
+// split_gic, and the container grows up to the highest index inserted.
+//
+// Each slot holds a copy of the generation of the key it was inserted with, so
+// that keys of elements removed from the owning container are rejected as soon
+// as the owner reuses their slot. Since keys of living elements always have
+// valid (even) generations, an odd generation marks an empty slot.
+//
+// Values of keys removed from the owning container stay until they are removed
+// from here or overwritten; iterating yields them too.
+template<class Key,
+         typename V,
+         template<class...> class ObjectContainer = std::vector,
+         class GenerationContainer = std::vector<typename Key::generation_type>>
+class secondary_map {
+public:
+    using key_type = Key;
+    using mapped_type = V;
+    using value_type = V;
+    using index_type = typename key_type::index_type;
+    using generation_type = typename key_type::generation_type;
+    using element_access_type = boost::optional<V&>;
+    using element_const_access_type = boost::optional<V const&>;
+
+    using wrapped_type = detail::manually_destructed<V>;
+    using wrapped_object_container = ObjectContainer<wrapped_type>;
+
+    using iterator = detail::split_gic_iterator<
+        GenerationContainer,
+        wrapped_object_container>;
+
+    using const_iterator = detail::split_gic_iterator<
+        GenerationContainer const,
+        wrapped_object_container const>;
+
+    secondary_map() = default;
+
+    secondary_map(secondary_map const& other) :
+        generations(other.generations)
+    {
+        detail::copy_live_objects(generations, other.objects, objects);
+    }
+
+    secondary_map(secondary_map&& other) noexcept : secondary_map() {
+        swap(other);
+    }
+
+    secondary_map& operator=(secondary_map const& other) {
+        secondary_map copy(other);
+        swap(copy);
+        return *this;
+    }
+
+    secondary_map& operator=(secondary_map&& other) noexcept {
+        secondary_map moved(std::move(other));
+        swap(moved);
+        return *this;
+    }
+
+    ~secondary_map() {
+        detail::destroy_live_objects(generations, objects);
+    }
+
+    void swap(secondary_map& other) noexcept {
+        using std::swap;
+        swap(generations, other.generations);
+        swap(objects, other.objects);
+    }
+
+    friend void swap(secondary_map& a, secondary_map& b) noexcept {
+        a.swap(b);
+    }
+
+    // Constructs the value of k from args, replacing the value that was
+    // associated with k or with an older key of the same index.
+    template<typename... Args>
+    V& insert(key_type const& k, Args&&... args) {
+        auto const idx = k.get_index();
+
+        if(idx >= generations.size()) {
+            if(idx >= objects.size()) {
+                grow_objects(std::max<std::size_t>(idx + 1,
+                                                   objects.size() * 2));
+            }
+
+            generations.resize(idx + 1, empty_generation);
+        }
+        else if(detail::is_valid(generations[idx])) {
+            objects[idx].erase();
+            generations[idx] = empty_generation;
+        }
+
+        V& value = objects[idx].emplace(std::forward<Args>(args)...);
+        generations[idx] = k.get_generation();
+        return value;
+    }
+
+    bool is_present(key_type const& k) const {
+        return k.get_index() < generations.size() &&
+               k.get_generation() == generations[k.get_index()];
+    }
+
+    [[nodiscard]] element_access_type get(key_type const& k) {
+        return make_optional_ref(get_ptr(k));
+    }
+
+    [[nodiscard]] element_const_access_type get(key_type const& k) const {
+        return make_optional_ref(get_ptr(k));
+    }
+
+    [[nodiscard]] element_access_type operator[](key_type const& k) {
+        return get(k);
+    }
+
+    [[nodiscard]] element_const_access_type
+    operator[](key_type const& k) const {
+        return get(k);
+    }
+
+    [[nodiscard]] element_access_type failed_get() {
+        return {};
+    }
+
+    [[nodiscard]] element_const_access_type failed_get() const {
+        return {};
+    }
+
+    [[nodiscard]] V* get_ptr(key_type const& k) {
+        return is_present(k) ? objects[k.get_index()].get_pointer() : nullptr;
+    }
+
+    [[nodiscard]] V const* get_ptr(key_type const& k) const {
+        return is_present(k) ? objects[k.get_index()].get_pointer() : nullptr;
+    }
+
+    void remove(key_type const& k) {
+        if(is_present(k)) {
+            auto const idx = k.get_index();
+            objects[idx].erase();
+            generations[idx] = empty_generation;
+        }
+    }
+
+    iterator begin() {
+        return make_iterator(*this,
+                             detail::begin_getter_v,
+                             detail::end_getter_v);
+    }
+
+    const_iterator cbegin() const {
+        return make_iterator(*this,
+                             detail::cbegin_getter_v,
+                             detail::cend_getter_v);
+    }
+
+    const_iterator begin() const {
+        return cbegin();
+    }
+
+    iterator end() {
+        return make_iterator(*this,
+                             detail::end_getter_v,
+                             detail::end_getter_v);
+    }
+
+    const_iterator cend() const {
+        return make_iterator(*this,
+                             detail::cend_getter_v,
+                             detail::cend_getter_v);
+    }
+
+    const_iterator end() const {
+        return cend();
+    }
+
+private:
+    static constexpr generation_type empty_generation{1};
+
+    GenerationContainer generations;
+    wrapped_object_container objects;
+
+    // Same as split_gic: only the living objects are moved.
+    void grow_objects(std::size_t capacity) {
+        wrapped_object_container grown(capacity);
+        detail::relocate_live_objects(generations, objects, grown);
+        objects.swap(grown);
+    }
+
+    template<typename Value>
+    static boost::optional<Value&> make_optional_ref(Value* ptr) {
+        if(ptr == nullptr) {
+            return {};
+        }
+
+        return {*ptr};
+    }
+
+    template <typename Self, typename BG, typename EG>
+    static decltype(auto)
+    make_iterator(Self& self, BG&& begin_getter, EG&& end_getter) {
+        return PERFECT_BACKWARD(
+            detail::make_split_gic_iterator(self.generations,
+                                            self.objects,
+                                            begin_getter,
+                                            end_getter));
+    }
+};
+
+} // end namespace genex
+
+#endif // SECONDARY_MAP_HPP
@@ -0,0 +1,308 @@
+#ifndef SHARDED_GIC_HPP
+#define SHARDED_GIC_HPP
+
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <iterator>
+#include <utility>
+#include <type_traits>
+
+#include <boost/iterator/iterator_facade.hpp>
+
+#include "detail/key_placeholding.hpp"
+
+namespace genex {
+
+namespace detail {
+
+constexpr std::size_t cache_line_size = 64;
+
+// Each shard on its own cache lines, so that threads updating the bookkeeping
+// of neighbouring shards do not invalidate each other's caches.
+template<class Gic>
+struct alignas(cache_line_size) padded_shard {
+    Gic gic;
+};
+
+// Iterates over the elements of every shard, one shard after the other.
+template<class Shard, class ShardIterator>
+class sharded_iterator : public boost::iterator_facade<
+        sharded_iterator<Shard, ShardIterator>,
+        typename std::iterator_traits<ShardIterator>::value_type,
+        boost::forward_traversal_tag,
+        typename std::iterator_traits<ShardIterator>::reference>
+{
+public:
+    sharded_iterator() = default;
+
+    // Skips the empty shards, so that reaching the end of a shard other than
+    // the last one never happens.
+    sharded_iterator(Shard* first, Shard* last, ShardIterator first_it)
+        : shard(first), last_shard(last), it(first_it)
+    {
+        skip_exhausted_shards();
+    }
+
+    // iterator to const_iterator
+    template<class OtherShard,
+             class OtherIterator,
+             typename std::enable_if_t<
+                 std::is_convertible_v<OtherShard*, Shard*> &&
+                 std::is_convertible_v<OtherIterator, ShardIterator>,
+                 int> = 0>
+    sharded_iterator(
+            sharded_iterator<OtherShard, OtherIterator> const& other)
+        : shard(other.shard), last_shard(other.last_shard), it(other.it)
+    {}
+
+private:
+    friend class boost::iterator_core_access;
+    template<class, class> friend class sharded_iterator;
+
+    decltype(auto) dereference() const {
+        return *it;
+    }
+
+    template<class OtherShard, class OtherIterator>
+    bool equal(
+            sharded_iterator<OtherShard, OtherIterator> const& other) const
+    {
+        return shard == other.shard && it == other.it;
+    }
+
+    void increment() {
+        ++it;
+        skip_exhausted_shards();
+    }
+
+    void skip_exhausted_shards() {
+        while(shard != last_shard && it == shard_end(*shard)) {
+            ++shard;
+            it = shard_begin(*shard);
+        }
+    }
+
+    static ShardIterator shard_begin(Shard& s) {
+        if constexpr (std::is_const_v<Shard>) {
+            return s.gic.cbegin();
+        }
+        else {
+            return s.gic.begin();
+        }
+    }
+
+    static ShardIterator shard_end(Shard& s) {
+        if constexpr (std::is_const_v<Shard>) {
+            return s.gic.cend();
+        }
+        else {
+            return s.gic.end();
+        }
+    }
+
+    Shard* shard = nullptr;
+    Shard* last_shard = nullptr;
+    ShardIterator it;
+};
+
+} // end namespace detail
+
+// A genex container split into Shards independent containers, typically one
+// per worker thread, so that threads emplace and remove elements concurrently
+// without sharing a free list.
+//
+// Keys of all shards live in a single key space: the index of a key is
+// local_index * Shards + shard_id, hence any key can be routed to its shard
+// and global keys of different shards never collide.
+//
+// Concurrency is by ownership, as in the rest of the library there is no
+// synchronization: a shard may be modified by one thread at a time, through
+// shard(id) or by removing one of its keys, and reading a shard while it is
+// modified is a data race. Global lookups and iteration are meant for the
+// phases where no shard is being modified.
+//
+// Objects cannot be given their key through key_placeholder, since only the
+// shard-local key is known while they are constructed.
+template<class Gic, std::size_t Shards>
+class sharded_gic {
+    static_assert(Shards != 0, "a sharded_gic needs at least one shard");
+
+public:
+    using shard_container = Gic;
+    using value_type = typename Gic::value_type;
+    using key_type = typename Gic::key_type;
+    using index_type = typename key_type::index_type;
+    using generation_type = typename key_type::generation_type;
+    using element_access_type = typename Gic::element_access_type;
+    using element_const_access_type =
+        typename Gic::element_const_access_type;
+
+private:
+    using shard_type = detail::padded_shard<Gic>;
+
+public:
+    using iterator = detail::sharded_iterator<
+        shard_type,
+        typename Gic::iterator>;
+    using const_iterator = detail::sharded_iterator<
+        shard_type const,
+        typename Gic::const_iterator>;
+
+    // Access to one shard, which emplaces and removes elements with global
+    // keys. Cheap to copy, meant to be handed to the thread owning the shard.
+    class shard_handle {
+    public:
+        template<typename... Args>
+        [[nodiscard]] key_type emplace(Args&&... args) {
+            return std::get<0>(emplace_and_get(std::forward<Args>(args)...));
+        }
+
+        template<typename... Args>
+        [[nodiscard]] std::pair<key_type, value_type&>
+        emplace_and_get(Args&&... args) {
+            static_assert(!detail::has_key_placeholder_v<Args...>,
+                          "sharded_gic does not support key placeholders");
+
+            auto [local_key, obj] =
+                local().emplace_and_get(std::forward<Args>(args)...);
+            return {to_global(local_key, id), obj};
+        }
+
+        // Does nothing if k belongs to another shard, like is_present: the
+        // other shard may be in the hands of another thread.
+        void remove(key_type const& k) {
+            if(shard_of(k) == id) {
+                local().remove(to_local(k));
+            }
+        }
+
+        [[nodiscard]] bool is_present(key_type const& k) const {
+            return shard_of(k) == id && local().is_present(to_local(k));
+        }
+
+        std::size_t shard_id() const noexcept {
+            return id;
+        }
+
+        Gic& local() const noexcept {
+            return owner->shards[id].gic;
+        }
+
+    private:
+        friend class sharded_gic;
+
+        shard_handle(sharded_gic* owner, std::size_t id)
+            : owner(owner), id(id)
+        {}
+
+        sharded_gic* owner;
+        std::size_t id;
+    };
+
+    [[nodiscard]] static constexpr std::size_t shard_count() noexcept {
+        return Shards;
+    }
+
+    [[nodiscard]] static constexpr std::size_t
+    shard_of(key_type const& k) noexcept {
+        return static_cast<std::size_t>(k.get_index() % Shards);
+    }
+
+    [[nodiscard]] shard_handle shard(std::size_t id) noexcept {
+        assert(id < Shards);
+        return {this, id};
+    }
+
+    [[nodiscard]] Gic const& shard(std::size_t id) const noexcept {
+        assert(id < Shards);
+        return shards[id].gic;
+    }
+
+    // ===== Routed by the shard of the key =====
+
+    [[nodiscard]] element_access_type get(key_type const& k) {
+        return route(k).get(to_local(k));
+    }
+
+    [[nodiscard]] element_const_access_type get(key_type const& k) const {
+        return route(k).get(to_local(k));
+    }
+
+    [[nodiscard]] element_access_type operator[](key_type const& k) {
+        return get(k);
+    }
+
+    [[nodiscard]] element_const_access_type
+    operator[](key_type const& k) const {
+        return get(k);
+    }
+
+    [[nodiscard]] value_type* get_ptr(key_type const& k) {
+        return route(k).get_ptr(to_local(k));
+    }
+
+    [[nodiscard]] value_type const* get_ptr(key_type const& k) const {
+        return route(k).get_ptr(to_local(k));
+    }
+
+    [[nodiscard]] bool is_present(key_type const& k) const {
+        return route(k).is_present(to_local(k));
+    }
+
+    // Modifies the shard of k, see the class comment.
+    void remove(key_type const& k) {
+        route(k).remove(to_local(k));
+    }
+
+    // ===== Iteration over all the shards =====
+
+    iterator begin() {
+        return {shards.data(), &shards.back(), shards.front().gic.begin()};
+    }
+
+    iterator end() {
+        return {&shards.back(), &shards.back(), shards.back().gic.end()};
+    }
+
+    const_iterator cbegin() const {
+        return {shards.data(), &shards.back(), shards.front().gic.cbegin()};
+    }
+
+    const_iterator cend() const {
+        return {&shards.back(), &shards.back(), shards.back().gic.cend()};
+    }
+
+    const_iterator begin() const {
+        return cbegin();
+    }
+
+    const_iterator end() const {
+        return cend();
+    }
+
+private:
+    std::array<shard_type, Shards> shards;
+
+    static key_type to_global(key_type const& local, std::size_t id) {
+        return {static_cast<index_type>(local.get_index() * Shards + id),
+                local.get_generation()};
+    }
+
+    static key_type to_local(key_type const& global) {
+        return {static_cast<index_type>(global.get_index() / Shards),
+                global.get_generation()};
+    }
+
+    Gic& route(key_type const& k) {
+        return shards[shard_of(k)].gic;
+    }
+
+    Gic const& route(key_type const& k) const {
+        return shards[shard_of(k)].gic;
+    }
+};
+
+} // end namespace genex
+
+#endif // SHARDED_GIC_HPP
@@ -0,0 +1,279 @@
+#ifndef SPARSE_SECONDARY_MAP_HPP
+#define SPARSE_SECONDARY_MAP_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include <boost/optional.hpp>
+
+#include "key.hpp"
+
+namespace genex {
+
+// Associates values to the keys of another genex container, like
+// secondary_map, but for values that only few of its elements have.
+//
+// The keys and values are stored contiguously, in insertion order up to
+// removals which move the last entry into the hole, so iterating over them is
+// iterating over a plain array. They are found with an open-addressing hash
+// table of positions in those arrays, indexed by the index of the keys: the
+// index of a key is unique among the living elements of its container, it is
+// the generation check that rejects stale keys.
+template<class Key,
+         typename V,
+         class KeyContainer = std::vector<Key>,
+         class ValueContainer = std::vector<V>>
+class sparse_secondary_map {
+public:
+    using key_type = Key;
+    using mapped_type = V;
+    using value_type = V;
+    using index_type = typename key_type::index_type;
+    using generation_type = typename key_type::generation_type;
+    using element_access_type = boost::optional<V&>;
+    using element_const_access_type = boost::optional<V const&>;
+
+    using iterator = typename ValueContainer::iterator;
+    using const_iterator = typename ValueContainer::const_iterator;
+
+    // Constructs the value of k from args, replacing the value that was
+    // associated with k or with an older key of the same index.
+    template<typename... Args>
+    V& insert(key_type const& k, Args&&... args) {
+        std::size_t const bucket = find_bucket(k.get_index());
+        if(bucket != no_bucket) {
+            position_type const pos = buckets[bucket] - 1;
+            values[pos] = V(std::forward<Args>(args)...);
+            keys[pos] = k;
+            return values[pos];
+        }
+
+        if((keys.size() + 1) * 2 > buckets.size()) {
+            rehash(buckets.empty() ? min_bucket_count : buckets.size() * 2);
+        }
+
+        values.emplace_back(std::forward<Args>(args)...);
+        keys.push_back(k);
+        buckets[free_bucket_for(k.get_index())] = keys.size();
+        return values.back();
+    }
+
+    bool is_present(key_type const& k) const {
+        return find(k) != no_position;
+    }
+
+    [[nodiscard]] element_access_type get(key_type const& k) {
+        return make_optional_ref(get_ptr(k));
+    }
+
+    [[nodiscard]] element_const_access_type get(key_type const& k) const {
+        return make_optional_ref(get_ptr(k));
+    }
+
+    [[nodiscard]] element_access_type operator[](key_type const& k) {
+        return get(k);
+    }
+
+    [[nodiscard]] element_const_access_type
+    operator[](key_type const& k) const {
+        return get(k);
+    }
+
+    [[nodiscard]] element_access_type failed_get() {
+        return {};
+    }
+
+    [[nodiscard]] element_const_access_type failed_get() const {
+        return {};
+    }
+
+    [[nodiscard]] V* get_ptr(key_type const& k) {
+        position_type const pos = find(k);
+        return pos == no_position ? nullptr : &values[pos];
+    }
+
+    [[nodiscard]] V const* get_ptr(key_type const& k) const {
+        position_type const pos = find(k);
+        return pos == no_position ? nullptr : &values[pos];
+    }
+
+    void remove(key_type const& k) {
+        std::size_t const bucket = find_bucket(k.get_index());
+        if(bucket == no_bucket) {
+            return;
+        }
+
+        position_type const pos = buckets[bucket] - 1;
+        if(keys[pos].get_generation() != k.get_generation()) {
+            return;
+        }
+
+        erase_bucket(bucket);
+
+        // the last entry fills the hole
+        position_type const last = keys.size() - 1;
+        if(pos != last) {
+            buckets[find_bucket(keys[last].get_index())] = pos + 1;
+            values[pos] = std::move(values[last]);
+            keys[pos] = std::move(keys[last]);
+        }
+        values.pop_back();
+        keys.pop_back();
+    }
+
+    std::size_t size() const noexcept {
+        return keys.size();
+    }
+
+    bool empty() const noexcept {
+        return keys.empty();
+    }
+
+    // The keys of the values, in the order of iteration.
+    KeyContainer const& present_keys() const noexcept {
+        return keys;
+    }
+
+    iterator begin() {
+        return values.begin();
+    }
+
+    const_iterator cbegin() const {
+        return values.cbegin();
+    }
+
+    const_iterator begin() const {
+        return cbegin();
+    }
+
+    iterator end() {
+        return values.end();
+    }
+
+    const_iterator cend() const {
+        return values.cend();
+    }
+
+    const_iterator end() const {
+        return cend();
+    }
+
+private:
+    // position in keys and values, plus one so that 0 marks an empty bucket
+    using position_type = std::size_t;
+    using bucket_container = std::vector<position_type>;
+
+    static constexpr position_type no_position = ~position_type{0};
+    static constexpr std::size_t no_bucket = ~std::size_t{0};
+    static constexpr std::size_t min_bucket_count = 8;
+
+    KeyContainer keys;
+    ValueContainer values;
+
+    // power-of-two sized, at most half full
+    bucket_container buckets;
+    unsigned bucket_shift = 0;
+
+    template<typename Value>
+    static boost::optional<Value&> make_optional_ref(Value* ptr) {
+        if(ptr == nullptr) {
+            return {};
+        }
+
+        return {*ptr};
+    }
+
+    // Fibonacci hashing: consecutive indexes, which are the common case, end
+    // up far from each other.
+    std::size_t home_bucket(index_type const& idx) const {
+        auto const h = static_cast<std::uint64_t>(idx) *
+                       UINT64_C(11400714819323198485);
+        return static_cast<std::size_t>(h >> bucket_shift);
+    }
+
+    std::size_t next_bucket(std::size_t bucket) const {
+        return (bucket + 1) & (buckets.size() - 1);
+    }
+
+    std::size_t find_bucket(index_type const& idx) const {
+        if(buckets.empty()) {
+            return no_bucket;
+        }
+
+        for(std::size_t b = home_bucket(idx);
+            buckets[b] != 0;
+            b = next_bucket(b))
+        {
+            if(keys[buckets[b] - 1].get_index() == idx) {
+                return b;
+            }
+        }
+
+        return no_bucket;
+    }
+
+    position_type find(key_type const& k) const {
+        std::size_t const bucket = find_bucket(k.get_index());
+        if(bucket == no_bucket) {
+            return no_position;
+        }
+
+        position_type const pos = buckets[bucket] - 1;
+        return keys[pos].get_generation() == k.get_generation()
+                ? pos
+                : no_position;
+    }
+
+    std::size_t free_bucket_for(index_type const& idx) const {
+        std::size_t b = home_bucket(idx);
+        while(buckets[b] != 0) {
+            b = next_bucket(b);
+        }
+        return b;
+    }
+
+    // Backward-shift deletion: the following entries of the probe sequence
+    // are moved back so that no tombstone is needed.
+    void erase_bucket(std::size_t hole) {
+        buckets[hole] = 0;
+
+        for(std::size_t b = next_bucket(hole);
+            buckets[b] != 0;
+            b = next_bucket(b))
+        {
+            std::size_t const home =
+                    home_bucket(keys[buckets[b] - 1].get_index());
+
+            // an entry can only move back if its home bucket is not in the
+            // cyclic range (hole, b]
+            bool const home_after_hole = hole <= b
+                    ? (hole < home && home <= b)
+                    : (hole < home || home <= b);
+
+            if(!home_after_hole) {
+                buckets[hole] = buckets[b];
+                buckets[b] = 0;
+                hole = b;
+            }
+        }
+    }
+
+    void rehash(std::size_t bucket_count) {
+        buckets.assign(bucket_count, 0);
+
+        bucket_shift = 64;
+        for(std::size_t c = bucket_count; c > 1; c /= 2) {
+            --bucket_shift;
+        }
+
+        for(position_type pos = 0; pos != keys.size(); ++pos) {
+            buckets[free_bucket_for(keys[pos].get_index())] = pos + 1;
+        }
+    }
+};
+
+} // end namespace genex
+
+#endif // SPARSE_SECONDARY_MAP_HPP
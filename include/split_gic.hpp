@@ -1,17 +1,28 @@
 #ifndef SPLIT_GENERATIONALLY_INDEXED_CONTAINER_HPP
 #define SPLIT_GENERATIONALLY_INDEXED_CONTAINER_HPP
 
+#include <cassert>
 #include <cstddef>
+#include <cstring>
 #include <utility>
 #include <functional>
 #include <algorithm>
 #include <vector>
 #include <iterator>
+#include <memory>
 #include <type_traits>
 
 #include "gic_with_generations.hpp"
 #include "key.hpp"
+#include "relocation.hpp"
+#include "secondary_map.hpp"
+#include "delta.hpp"
+#include "element_run.hpp"
+#include "memory_usage.hpp"
+#include "statistics.hpp"
 #include "detail/manually_destructed.hpp"
+#include "detail/free_lists.hpp"
+#include "detail/live_objects.hpp"
 #include "detail/element_validity_embedded_in_generation.hpp"
 #include "detail/split_gic_iterator.hpp"
 #include "detail/perfect_backward.hpp"
@@ -22,11 +33,15 @@ namespace genex {
 // A generationnally indexed container where the objects, their generation and
 // the indexes of freed objects are in separate containers and whether an object
 // is free or not is determined by the generation.
+//
+// With intrusive_free_list as IndexContainer, the indexes of freed objects are
+// stored in the free slots instead, see intrusive_free_list.
 template<typename T,
          template<class...> class ObjectContainer = std::vector,
          class Key = key<T>,
          class IndexContainer = std::vector<typename Key::index_type>,
-         class GenerationContainer = std::vector<typename Key::generation_type>>
+         class GenerationContainer = std::vector<typename Key::generation_type>,
+         class Statistics = no_statistics>
 class split_gic :
         public gic_with_generations<
             split_gic<
@@ -34,15 +49,17 @@ class split_gic :
                 ObjectContainer,
                 Key,
                 IndexContainer,
-                GenerationContainer>,
+                GenerationContainer,
+                Statistics>,
             T,
             Key,
-            GenerationContainer
+            GenerationContainer,
+            Statistics
         >
 {
 private:
-    using parent_type =
-        gic_with_generations<split_gic, T, Key, GenerationContainer>;
+    using parent_type = gic_with_generations<
+        split_gic, T, Key, GenerationContainer, Statistics>;
 
     // without this line, we can only refer to 'generations' with
     // 'this->generations' because the base class is templated.
@@ -53,75 +70,629 @@ public:
     using index_type = typename key_type::index_type;
     using generation_type = typename key_type::generation_type;
 
-    using wrapped_type = detail::manually_destructed<T>;
+private:
+    using free_list_type = detail::free_list_for<IndexContainer, index_type>;
+
+public:
+    using wrapped_type = typename free_list_type::template wrapped_type<T>;
     using wrapped_object_container = ObjectContainer<wrapped_type>;
 
     using iterator = detail::split_gic_iterator<
         GenerationContainer,
-        wrapped_object_container>;
+        wrapped_object_container,
+        Statistics>;
 
     using const_iterator = detail::split_gic_iterator<
         GenerationContainer const,
-        wrapped_object_container const>;
+        wrapped_object_container const,
+        Statistics>;
+
+    // Slots appended by reserve_keys, whose objects may be constructed from
+    // several threads at once, each slot by a single thread. They are free
+    // slots until commit() is called, after every object was constructed.
+    //
+    // Until then, the reservation owns the objects constructed so far: when
+    // cancelled or destroyed, e.g. after a worker threw, it destroys them and
+    // drops its slots.
+    class key_reservation {
+    public:
+        key_reservation(key_reservation&& other) noexcept
+            : owner(std::exchange(other.owner, nullptr)),
+              slots(other.slots),
+              first(other.first),
+              count(other.count),
+              generation(other.generation),
+              constructed(std::move(other.constructed))
+        {}
+
+        key_reservation& operator=(key_reservation&& other) noexcept {
+            if(this != &other) {
+                cancel();
+                owner = std::exchange(other.owner, nullptr);
+                slots = other.slots;
+                first = other.first;
+                count = other.count;
+                generation = other.generation;
+                constructed = std::move(other.constructed);
+            }
+            return *this;
+        }
+
+        ~key_reservation() {
+            cancel();
+        }
+
+        [[nodiscard]] std::size_t size() const noexcept {
+            return count;
+        }
+
+        [[nodiscard]] key_type key(std::size_t i) const noexcept {
+            return {static_cast<index_type>(first + i), generation};
+        }
+
+        template<typename... Args>
+        T& construct(std::size_t i, Args&&... args) {
+            assert(owner != nullptr);
+            assert(!constructed[i]);
+            auto const k = key(i);
+            T& object = slots[i].emplace(
+                        detail::forward_arg_or_key<Args>(
+                            std::forward<Args>(args), k)...);
+            constructed[i] = true;
+            return object;
+        }
+
+        // Destroys the objects constructed so far and drops the slots. Does
+        // nothing once committed.
+        void cancel() noexcept {
+            if(owner != nullptr) {
+                std::exchange(owner, nullptr)->cancel_reservation(*this);
+            }
+        }
+
+    private:
+        friend class split_gic;
+
+        key_reservation(split_gic* owner,
+                        wrapped_type* slots,
+                        std::size_t first,
+                        std::size_t count,
+                        generation_type generation,
+                        std::unique_ptr<bool[]> constructed)
+            : owner(owner),
+              slots(slots),
+              first(first),
+              count(count),
+              generation(generation),
+              constructed(std::move(constructed))
+        {}
+
+        // null once committed or cancelled
+        split_gic* owner;
+        wrapped_type* slots;
+        std::size_t first;
+        std::size_t count;
+        generation_type generation;
+        // one flag per slot, so that threads never write the same one
+        std::unique_ptr<bool[]> constructed;
+    };
+
+    // New key of each element of another container after splice or merge,
+    // looked up with its old key.
+    using key_map = secondary_map<key_type, key_type>;
+
+    using delta_type = gic_delta<T, key_type>;
 
     split_gic() = default;
 
+    // Only the living objects are copied, the generations and the free list
+    // are copied as a whole: the copy reuses the free slots in the same order.
+    split_gic(split_gic const& other) :
+        parent_type(other),
+        free_list(other.free_list),
+        appended_generation(other.appended_generation)
+    {
+        assert(other.outstanding_reservations == 0);
+        detail::copy_live_objects(generations, other.objects, objects);
+        free_list.relink(generations, other.objects, objects);
+    }
+
+    split_gic(split_gic&& other) noexcept : split_gic() {
+        swap(other);
+    }
+
+    split_gic& operator=(split_gic const& other) {
+        split_gic copy(other);
+        swap(copy);
+        return *this;
+    }
+
+    split_gic& operator=(split_gic&& other) noexcept {
+        split_gic moved(std::move(other));
+        swap(moved);
+        return *this;
+    }
+
     ~split_gic() {
+        assert(outstanding_reservations == 0);
         // all living objects must be destroyed
-        auto obj_it = objects.begin();
-        auto gen_it = generations.cbegin();
-        for(const auto gen_end = generations.cend();
-            gen_it != gen_end;
-            ++gen_it, ++obj_it)
-        {
-            if(genex::detail::is_valid(*gen_it)) {
-                obj_it->erase();
-            }
-        }
+        detail::destroy_live_objects(generations, objects);
+    }
+
+    [[nodiscard]] split_gic clone() const {
+        return *this;
+    }
+
+    // The statistics stay with each container, as with copies and moves,
+    // which are built on swap.
+    void swap(split_gic& other) noexcept {
+        assert(outstanding_reservations == 0);
+        assert(other.outstanding_reservations == 0);
+        using std::swap;
+        swap(generations, other.generations);
+        swap(objects, other.objects);
+        free_list.swap(other.free_list);
+        swap(appended_generation, other.appended_generation);
+    }
+
+    friend void swap(split_gic& a, split_gic& b) noexcept {
+        a.swap(b);
     }
 
     template<typename... Args>
     [[nodiscard]] std::pair<key_type, T&> emplace_and_get(Args&&... args) {
-        if (free_indexes.empty()) {
-            key_type k{index_type{objects.size()},
-                       generations.emplace_back()};
-            auto& slot = objects.emplace_back(
-                        detail::forward_arg_or_key<Args>(args, k)...);
+        if (free_list.empty()) {
+            assert(outstanding_reservations == 0);
+            auto const idx = generations.size();
+            bool const reallocating = idx == objects.size();
+            if(reallocating) {
+                reallocate_objects(idx == 0 ? 1 : idx * 2);
+            }
+
+            key_type k{index_type{idx}, appended_generation};
+            T& obj = objects[idx].emplace(
+                        detail::forward_arg_or_key<Args>(
+                            std::forward<Args>(args), k)...);
+            try {
+                generations.push_back(appended_generation);
+            }
+            catch(...) {
+                objects[idx].erase();
+                throw;
+            }
 
-            return {k, *slot};
+            this->statistics_policy().on_emplace_at_back(reallocating);
+            return {k, obj};
         }
         else {
-            auto idx = free_indexes.back();
-            free_indexes.pop_back();
+            auto idx = free_list.pop(objects);
             key_type k{idx, ++generations[idx]};
             T& obj = objects[idx].emplace(
-                        detail::forward_arg_or_key<Args>(args, k)...);
+                        detail::forward_arg_or_key<Args>(
+                            std::forward<Args>(args), k)...);
 
+            this->statistics_policy().on_emplace_in_free_slot();
             return {k, obj};
         }
     }
 
     void remove(key_type const &k) {
-        if(this->is_present(k)) {
+        bool const present = this->is_present(k);
+        this->statistics_policy().on_remove(present);
+
+        if(present) {
             auto idx = k.get_index();
             unchecked_erasure(std::forward<index_type>(idx));
         }
     }
 
     void erase(index_type&& index) {
-        if(genex::detail::is_valid(generations[index])) {
+        bool const present = genex::detail::is_valid(generations[index]);
+        this->statistics_policy().on_remove(present);
+
+        if(present) {
             unchecked_erasure(std::forward<index_type>(index));
         }
     }
 
+    // Appends n slots and gives their keys before their objects exist. Until
+    // the reservation is committed or cancelled, elements may only be
+    // emplaced in free slots and removed: appending, trimming, copying or
+    // moving the container could move or drop the reserved slots.
+    [[nodiscard]] key_reservation reserve_keys(std::size_t n) {
+        assert(outstanding_reservations == 0);
+        auto constructed = std::make_unique<bool[]>(n);
+        auto const first = generations.size();
+        if(first + n > objects.size()) {
+            reallocate_objects(std::max(first + n, first * 2));
+        }
+
+        // the slots look free, hence invisible, until commit
+        generations.resize(first + n, appended_generation + 1);
+        ++outstanding_reservations;
+        return {this,
+                objects.data() + first,
+                first,
+                n,
+                appended_generation,
+                std::move(constructed)};
+    }
+
+    // Makes the objects of the reservation, which must all be constructed,
+    // visible to get and iteration. The reservation keeps giving their keys.
+    void commit(key_reservation& reservation) {
+        // also fails if the reservation was already committed or cancelled
+        assert(reservation.owner == this);
+        for(std::size_t i = 0; i < reservation.size(); ++i) {
+            assert(reservation.constructed[i]);
+            generations[reservation.first + i] = reservation.generation;
+            this->statistics_policy().on_emplace_at_back(false);
+        }
+        reservation.owner = nullptr;
+        --outstanding_reservations;
+    }
+
+    // Moves every element of other into this container, filling the free
+    // slots first, then appending the others at once. Trivially relocatable
+    // objects are moved with memcpy, whole runs of them when appended. other
+    // is left empty.
+    key_map splice(split_gic& other) {
+        assert(&other != this);
+        auto mapping = transfer_from(other);
+
+        for(std::size_t i = 0; i < other.generations.size(); ++i) {
+            if(detail::is_valid(other.generations[i])) {
+                if constexpr (!is_trivially_relocatable_v<T>) {
+                    other.objects[i].erase();
+                }
+                ++other.generations[i];
+            }
+        }
+        other.trim();
+
+        return mapping;
+    }
+
+    // Same as splice, but copies the elements and leaves other as it is.
+    key_map merge(split_gic const& other) {
+        assert(&other != this);
+        return transfer_from(other);
+    }
+
+    // Drops the free slots at the back, and their indexes from the free list,
+    // e.g. after many elements were removed. Keeps the allocated memory.
+    void trim() {
+        assert(outstanding_reservations == 0);
+        auto size = generations.size();
+        while(size != 0 && !detail::is_valid(generations[size - 1])) {
+            // the keys of the dropped slots must stay invalid when those
+            // indexes are appended again
+            generation_type const next = generations[size - 1] + 1;
+            appended_generation = std::max(appended_generation, next);
+            --size;
+        }
+
+        if(size == generations.size()) {
+            return;
+        }
+
+        generations.erase(generations.begin() + size, generations.end());
+        free_list.trim(size, generations, objects);
+    }
+
+    // Trims, then releases the memory that is not used anymore.
+    void shrink_to_fit() {
+        trim();
+        if(objects.size() != generations.size()) {
+            reallocate_objects(generations.size());
+        }
+        generations.shrink_to_fit();
+        free_list.shrink_to_fit();
+    }
+
+    // Walks the generations to count the free slots and their longest run.
+    [[nodiscard]] gic_memory_usage memory_usage() const {
+        gic_memory_usage usage;
+        usage.objects = {objects.capacity() * sizeof(wrapped_type),
+                         generations.size() * sizeof(wrapped_type)};
+        usage.generations = detail::memory_of(generations);
+        usage.free_indexes = free_list.memory();
+        detail::count_slots(generations, usage);
+        return usage;
+    }
+
+    // What changed from baseline, an earlier state of this container such as
+    // a copy of it, to this state. Elements whose key did not change are
+    // compared with equal.
+    template<class Equal = bitwise_or_equal>
+    [[nodiscard]] delta_type delta_from(split_gic const& baseline,
+                                        Equal equal = {}) const
+    {
+        delta_type delta;
+        delta.slot_count = generations.size();
+        delta.appended_generation = appended_generation;
+
+        auto const& old_gens = baseline.generations;
+        auto const slots = std::max(old_gens.size(), generations.size());
+        for(std::size_t i = 0; i < slots; ++i) {
+            bool const was = i < old_gens.size() &&
+                             detail::is_valid(old_gens[i]);
+            bool const is = i < generations.size() &&
+                            detail::is_valid(generations[i]);
+            bool const same_key = was && is && old_gens[i] == generations[i];
+            auto const idx = static_cast<index_type>(i);
+
+            if(same_key) {
+                if(!equal(*baseline.objects[i], *objects[i])) {
+                    delta.modified.emplace_back(key_type{idx, generations[i]},
+                                                *objects[i]);
+                }
+                continue;
+            }
+            if(was) {
+                delta.destroyed.push_back(key_type{idx, old_gens[i]});
+            }
+            if(is) {
+                delta.created.emplace_back(key_type{idx, generations[i]},
+                                           *objects[i]);
+            }
+        }
+
+        return delta;
+    }
+
+    // Brings this container from the baseline of delta to the state it was
+    // computed from. Only a container in the state of the baseline, e.g. a
+    // copy of it updated by every delta since, may be given the delta.
+    //
+    // The elements and their keys are the same afterwards, the free slots
+    // are not: their order and generations are not in the delta. Emplacing
+    // in both containers may then give different keys.
+    void apply_delta(delta_type const& delta) {
+        apply_delta_from(delta);
+    }
+
+    // Same, but moves the objects out of delta.
+    void apply_delta(delta_type&& delta) {
+        apply_delta_from(delta);
+    }
+
+    // Calls f with an element_run for each maximal run of consecutive living
+    // slots, in the order of the slots, so that f can process the objects as
+    // arrays. When the slots are bigger than the objects, as they are with an
+    // intrusive_free_list and objects smaller than an index, the objects are
+    // not laid out as an array and each run is a single element.
+    template<typename F>
+    void for_each_run(F&& f) {
+        for_each_run_in(*this, f);
+    }
+
+    template<typename F>
+    void for_each_run(F&& f) const {
+        for_each_run_in(*this, f);
+    }
+
 private:
     ObjectContainer<wrapped_type> objects;
-    IndexContainer free_indexes;
+    free_list_type free_list;
+
+    // generation of the slots appended at the back, raised by trim()
+    generation_type appended_generation{};
+
+    // at most one, whose slots are at the back
+    std::size_t outstanding_reservations = 0;
+
+    template<class Self, typename F>
+    static void for_each_run_in(Self& self, F& f) {
+        constexpr bool contiguous = sizeof(wrapped_type) == sizeof(T);
+        auto const& gens = self.generations;
+        auto const slots = gens.size();
+
+        std::size_t i = 0;
+        while(i < slots) {
+            if(!detail::is_valid(gens[i])) {
+                ++i;
+                continue;
+            }
+
+            auto run_end = i + 1;
+            if constexpr (contiguous) {
+                while(run_end < slots && detail::is_valid(gens[run_end])) {
+                    ++run_end;
+                }
+            }
+
+            f(detail::prefix_view{self.objects[i].get_pointer(), run_end - i});
+            i = run_end;
+        }
+    }
+
+    template<class Delta>
+    void apply_delta_from(Delta& delta) {
+        assert(outstanding_reservations == 0);
+        constexpr bool moving = !std::is_const_v<Delta>;
+
+        for(auto const& k : delta.destroyed) {
+            assert(this->is_present(k));
+            auto const idx = k.get_index();
+            objects[idx].erase();
+            ++generations[idx];
+        }
+
+        appended_generation = std::max(appended_generation,
+                                       delta.appended_generation);
+        if(delta.slot_count > generations.size()) {
+            if(delta.slot_count > objects.size()) {
+                reallocate_objects(delta.slot_count);
+            }
+            generations.resize(delta.slot_count, appended_generation + 1);
+        }
+
+        for(auto& [k, object] : delta.created) {
+            auto const idx = k.get_index();
+            assert(idx < generations.size());
+            assert(!detail::is_valid(generations[idx]));
+            if constexpr (moving) {
+                objects[idx].emplace(std::move(object));
+            }
+            else {
+                objects[idx].emplace(object);
+            }
+            generations[idx] = k.get_generation();
+        }
+
+        for(auto& [k, object] : delta.modified) {
+            assert(this->is_present(k));
+            if constexpr (moving) {
+                *objects[k.get_index()] = std::move(object);
+            }
+            else {
+                *objects[k.get_index()] = object;
+            }
+        }
+
+        // the slots dropped by a trim since the baseline are free by now
+        if(delta.slot_count < generations.size()) {
+            assert(std::none_of(generations.begin() + delta.slot_count,
+                                generations.end(),
+                                [](auto g) { return detail::is_valid(g); }));
+            generations.resize(delta.slot_count);
+        }
+
+        free_list.rebuild(generations, objects);
+    }
+
+    // Replaces the objects container by one of capacity slots, into which
+    // only the living objects are moved, see detail/live_objects.hpp.
+    void reallocate_objects(std::size_t capacity) {
+        assert(outstanding_reservations == 0);
+        wrapped_object_container reallocated(capacity);
+        detail::relocate_live_objects(generations, objects, reallocated);
+        free_list.relink(generations, objects, reallocated);
+        objects.swap(reallocated);
+    }
+
+    // Constructs the living objects of other in this container, by copy if it
+    // is const, by move otherwise. Moved objects are left for the caller to
+    // discard, their slots are still occupied.
+    template<class Source>
+    key_map transfer_from(Source& other) {
+        assert(outstanding_reservations == 0);
+        constexpr bool moving = !std::is_const_v<Source>;
+        constexpr bool bitwise = moving ?
+            is_trivially_relocatable_v<T> : std::is_trivially_copyable_v<T>;
+
+        auto const construct = [&](wrapped_type& to, auto& from) {
+            if constexpr (bitwise) {
+                std::memcpy(static_cast<void*>(&to),
+                            static_cast<void const*>(&from),
+                            sizeof(wrapped_type));
+            }
+            else if constexpr (moving) {
+                to.emplace(std::move(*from));
+            }
+            else {
+                to.emplace(*from);
+            }
+        };
+
+        auto const slots = other.generations.size();
+        key_map mapping;
+        std::size_t i = 0;
+
+        // into the free slots, one at a time
+        for(; i < slots && !free_list.empty(); ++i) {
+            if(!detail::is_valid(other.generations[i])) {
+                continue;
+            }
+
+            auto const idx = free_list.pop(objects);
+            try {
+                construct(objects[idx], other.objects[i]);
+            }
+            catch(...) {
+                free_list.push(idx, objects);
+                throw;
+            }
+            key_type k{idx, ++generations[idx]};
+            mapping.insert(key_type{static_cast<index_type>(i),
+                                    other.generations[i]},
+                           k);
+            this->statistics_policy().on_emplace_in_free_slot();
+        }
+
+        // at the back, all at once
+        std::size_t remaining = 0;
+        for(auto j = i; j < slots; ++j) {
+            remaining += detail::is_valid(other.generations[j]) ? 1 : 0;
+        }
+
+        auto const used = generations.size();
+        bool const reallocating = used + remaining > objects.size();
+        if(reallocating) {
+            reallocate_objects(std::max(used + remaining, used * 2));
+        }
+        // so that an object is never constructed without its generation
+        if(generations.capacity() < used + remaining) {
+            generations.reserve(std::max(used + remaining, used * 2));
+        }
+
+        while(i < slots) {
+            if(!detail::is_valid(other.generations[i])) {
+                ++i;
+                continue;
+            }
+
+            auto run_end = i + 1;
+            if constexpr (bitwise) {
+                while(run_end < slots &&
+                      detail::is_valid(other.generations[run_end])) {
+                    ++run_end;
+                }
+            }
+
+            auto const first = generations.size();
+            auto const run = run_end - i;
+            if constexpr (bitwise) {
+                std::memcpy(static_cast<void*>(objects.data() + first),
+                            static_cast<void const*>(other.objects.data() + i),
+                            run * sizeof(wrapped_type));
+            }
+            else {
+                construct(objects[first], other.objects[i]);
+            }
+
+            for(std::size_t n = 0; n < run; ++n, ++i) {
+                generations.push_back(appended_generation);
+                mapping.insert(key_type{static_cast<index_type>(i),
+                                        other.generations[i]},
+                               key_type{static_cast<index_type>(first + n),
+                                        appended_generation});
+                // the reallocation is counted once, with the first element
+                this->statistics_policy().on_emplace_at_back(
+                            reallocating && first + n == used);
+            }
+        }
+
+        return mapping;
+    }
+
+    // The reserved slots are free and at the back: they are dropped along
+    // with the free slots before them, as by trim().
+    void cancel_reservation(key_reservation const& reservation) noexcept {
+        for(std::size_t i = 0; i < reservation.size(); ++i) {
+            if(reservation.constructed[i]) {
+                objects[reservation.first + i].erase();
+            }
+        }
+        --outstanding_reservations;
+        trim();
+    }
 
     void unchecked_erasure(index_type&& idx) {
         ++generations[idx];
         objects[idx].erase();
-        free_indexes.push_back(idx);
+        free_list.push(idx, objects);
     }
 
 
@@ -141,7 +712,8 @@ private:
             detail::make_split_gic_iterator(self.generations,
                                             self.objects,
                                             begin_getter,
-                                            end_getter));
+                                            end_getter,
+                                            &self.statistics_policy()));
     }
 };
 
@@ -0,0 +1,356 @@
+#ifndef STATIC_GIC_HPP
+#define STATIC_GIC_HPP
+
+#include <array>
+#include <cstddef>
+#include <optional>
+#include <stdexcept>
+#include <utility>
+#include <type_traits>
+
+#include "gic_base.hpp"
+#include "key.hpp"
+#include "statistics.hpp"
+#include "detail/manually_destructed.hpp"
+#include "detail/element_validity_embedded_in_generation.hpp"
+#include "detail/gic_core_access.hpp"
+#include "detail/iterator_utils.hpp"
+#include "detail/perfect_backward.hpp"
+#include "detail/key_placeholding.hpp"
+#include "detail/prefix_view.hpp"
+#include "detail/split_gic_iterator.hpp"
+
+namespace genex {
+
+namespace detail {
+
+// Slots that were never used and freed slots both have an odd generation.
+template<typename Generation>
+constexpr Generation static_gic_empty_generation{1};
+
+// Inline storage of a static_gic. Trivial objects are stored as they are and
+// constructed by assignment, which keeps the whole container usable in
+// constant expressions.
+template<typename T,
+         std::size_t N,
+         typename Generation,
+         typename Index,
+         bool = std::is_trivial_v<T>>
+struct static_gic_storage {
+    std::array<Generation, N> generations{};
+    std::array<T, N> objects{};
+    std::array<Index, N> free_indexes{};
+    std::size_t free_count = 0;
+    std::size_t used = 0;
+
+    constexpr static_gic_storage() {
+        for(auto& generation : generations) {
+            generation = static_gic_empty_generation<Generation>;
+        }
+    }
+
+    template<typename... Args>
+    constexpr T& construct(std::size_t idx, Args&&... args) {
+        objects[idx] = T(std::forward<Args>(args)...);
+        return objects[idx];
+    }
+
+    constexpr void destroy(std::size_t) {}
+
+    constexpr T* pointer(std::size_t idx) {
+        return &objects[idx];
+    }
+
+    constexpr T const* pointer(std::size_t idx) const {
+        return &objects[idx];
+    }
+};
+
+// Other objects live in manually_destructed slots, of which only the living
+// ones are copied and destroyed.
+template<typename T,
+         std::size_t N,
+         typename Generation,
+         typename Index>
+struct static_gic_storage<T, N, Generation, Index, false> {
+    std::array<Generation, N> generations;
+    std::array<manually_destructed<T>, N> objects;
+    std::array<Index, N> free_indexes;
+    std::size_t free_count = 0;
+    std::size_t used = 0;
+
+    static_gic_storage() {
+        generations.fill(static_gic_empty_generation<Generation>);
+    }
+
+    static_gic_storage(static_gic_storage const& other)
+        : static_gic_storage()
+    {
+        take_objects_of(other);
+    }
+
+    static_gic_storage(static_gic_storage&& other)
+        noexcept(std::is_nothrow_move_constructible_v<T>)
+        : static_gic_storage()
+    {
+        take_objects_of(std::move(other));
+    }
+
+    static_gic_storage& operator=(static_gic_storage const& other) {
+        if(this != &other) {
+            destroy_live_objects();
+            take_objects_of(other);
+        }
+        return *this;
+    }
+
+    static_gic_storage& operator=(static_gic_storage&& other)
+        noexcept(std::is_nothrow_move_constructible_v<T>)
+    {
+        if(this != &other) {
+            destroy_live_objects();
+            take_objects_of(std::move(other));
+        }
+        return *this;
+    }
+
+    ~static_gic_storage() {
+        destroy_live_objects();
+    }
+
+    template<typename... Args>
+    T& construct(std::size_t idx, Args&&... args) {
+        return objects[idx].emplace(std::forward<Args>(args)...);
+    }
+
+    void destroy(std::size_t idx) {
+        objects[idx].erase();
+    }
+
+    T* pointer(std::size_t idx) {
+        return objects[idx].get_pointer();
+    }
+
+    T const* pointer(std::size_t idx) const {
+        return objects[idx].get_pointer();
+    }
+
+private:
+    // Copies or moves the living objects of other into this empty storage. If
+    // one of them throws, the storage is left empty.
+    template<typename Storage>
+    void take_objects_of(Storage&& other) {
+        generations = other.generations;
+        free_indexes = other.free_indexes;
+        free_count = other.free_count;
+
+        try {
+            for(; used < other.used; ++used) {
+                if(!is_valid(generations[used])) {
+                    continue;
+                }
+
+                if constexpr (std::is_lvalue_reference_v<Storage>) {
+                    objects[used].emplace(*other.objects[used]);
+                }
+                else {
+                    objects[used].emplace(std::move(*other.objects[used]));
+                }
+            }
+        }
+        catch(...) {
+            destroy_live_objects();
+            throw;
+        }
+    }
+
+    void destroy_live_objects() noexcept {
+        if constexpr (!std::is_trivially_destructible_v<T>) {
+            for(std::size_t idx = 0; idx < used; ++idx) {
+                if(is_valid(generations[idx])) {
+                    objects[idx].erase();
+                }
+            }
+        }
+        generations.fill(static_gic_empty_generation<Generation>);
+        free_count = 0;
+        used = 0;
+    }
+};
+
+} // end namespace genex::detail
+
+// A generationnally indexed container of at most N elements that never
+// allocates: objects, generations and free indexes are arrays stored inline.
+// It suits containers that are small, numerous or created and destroyed often.
+//
+// Emplacing into a full container throws std::length_error, and try_emplace
+// returns an empty optional instead.
+//
+// For trivial objects, the container can be used in constant expressions.
+template<typename T,
+         std::size_t N,
+         class Key = key<T>,
+         class Statistics = no_statistics>
+class static_gic :
+        public gic_base<
+            static_gic<T, N, Key, Statistics>,
+            T,
+            Key,
+            Statistics
+        >
+{
+private:
+    using parent_type = gic_base<static_gic, T, Key, Statistics>;
+
+public:
+    using value_type = T;
+    using reference = T&;
+    using const_reference = T const&;
+    using key_type = typename parent_type::key_type;
+    using index_type = typename key_type::index_type;
+    using generation_type = typename key_type::generation_type;
+
+private:
+    using storage_type = detail::static_gic_storage<
+        T, N, generation_type, index_type>;
+
+    using wrapped_type = typename decltype(storage_type::objects)::value_type;
+
+    storage_type storage;
+
+    // ===== CRTP overrides =====
+
+    friend class detail::gic_core_access;
+
+    template<class Self>
+    static constexpr decltype(auto)
+    unchecked_get(Self& self, index_type const& idx) {
+        return PERFECT_BACKWARD(self.storage.pointer(idx));
+    }
+
+    static std::size_t slot_count(static_gic const& self) {
+        return self.storage.used;
+    }
+
+    static generation_type const&
+    slot_generation(static_gic const& self, std::size_t idx) {
+        return self.storage.generations[idx];
+    }
+
+
+    // ===== Iterator ====
+
+    // Only the slots used so far are iterated over.
+    template <typename Self, typename BG, typename EG>
+    static decltype(auto)
+    make_iterator(Self& self, BG&& begin_getter, EG&& end_getter) {
+        detail::prefix_view gens{self.storage.generations.data(),
+                                 self.storage.used};
+        detail::prefix_view objs{self.storage.objects.data(),
+                                 self.storage.used};
+
+        return PERFECT_BACKWARD(
+            detail::make_split_gic_iterator(gens,
+                                            objs,
+                                            begin_getter,
+                                            end_getter,
+                                            &self.statistics_policy()));
+    }
+
+public:
+    using iterator = detail::split_gic_iterator<
+        detail::prefix_view<generation_type>,
+        detail::prefix_view<wrapped_type>,
+        Statistics>;
+
+    using const_iterator = detail::split_gic_iterator<
+        detail::prefix_view<generation_type const>,
+        detail::prefix_view<wrapped_type const>,
+        Statistics>;
+
+
+    // ===== Core functionalities =====
+
+    static_gic() = default;
+
+    [[nodiscard]] static_gic clone() const {
+        return *this;
+    }
+
+    [[nodiscard]] static constexpr std::size_t capacity() noexcept {
+        return N;
+    }
+
+    [[nodiscard]] constexpr std::size_t size() const noexcept {
+        return storage.used - storage.free_count;
+    }
+
+    [[nodiscard]] constexpr bool full() const noexcept {
+        return storage.free_count == 0 && storage.used == N;
+    }
+
+    constexpr bool is_present(key_type const& k) const {
+        return k.get_index() < storage.used &&
+               k.get_generation() == storage.generations[k.get_index()];
+    }
+
+    template<typename... Args>
+    [[nodiscard]] constexpr std::pair<key_type, T&>
+    emplace_and_get(Args&&... args) {
+        if(full()) {
+            throw std::length_error("genex::static_gic is full");
+        }
+
+        bool const in_free_slot = storage.free_count != 0;
+        index_type const idx = in_free_slot ?
+            storage.free_indexes[storage.free_count - 1] :
+            static_cast<index_type>(storage.used);
+
+        // the slot is only taken once the object is constructed
+        key_type k{idx, generation_type(storage.generations[idx] + 1)};
+        T& obj = storage.construct(
+                    idx,
+                    detail::forward_arg_or_key<Args>(
+                        std::forward<Args>(args), k)...);
+        storage.generations[idx] = k.get_generation();
+
+        if(in_free_slot) {
+            --storage.free_count;
+            this->statistics_policy().on_emplace_in_free_slot();
+        }
+        else {
+            ++storage.used;
+            this->statistics_policy().on_emplace_at_back(false);
+        }
+
+        return {k, obj};
+    }
+
+    // Same as emplace, but does nothing and returns no key when full.
+    template<typename... Args>
+    [[nodiscard]] constexpr std::optional<key_type>
+    try_emplace(Args&&... args) {
+        if(full()) {
+            return std::nullopt;
+        }
+
+        return this->emplace(std::forward<Args>(args)...);
+    }
+
+    constexpr void remove(key_type const& k) {
+        bool const present = is_present(k);
+        this->statistics_policy().on_remove(present);
+
+        if(present) {
+            auto const idx = k.get_index();
+            ++storage.generations[idx];
+            storage.destroy(idx);
+            storage.free_indexes[storage.free_count++] = idx;
+        }
+    }
+};
+
+} // end namespace genex
+
+#endif // STATIC_GIC_HPP
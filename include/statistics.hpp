@@ -0,0 +1,95 @@
+#ifndef GIC_STATISTICS_HPP
+#define GIC_STATISTICS_HPP
+
+#include <cstddef>
+
+namespace genex {
+
+// Counters of the events that happened in a genex container, as returned by
+// its statistics() member function.
+struct gic_statistics {
+    // calls to get (and operator[]) with a key of a present/absent element
+    std::size_t successful_gets = 0;
+    std::size_t failed_gets = 0;
+
+    // emplacements that reused a freed slot versus ones that appended a new
+    // slot, and how many of the latter reallocated the objects
+    std::size_t emplacements_in_free_slots = 0;
+    std::size_t emplacements_at_back = 0;
+    std::size_t reallocations = 0;
+
+    // calls to remove with a key of a present/absent element
+    std::size_t removals = 0;
+    std::size_t failed_removals = 0;
+
+    // free slots the iterators had to step over
+    std::size_t skipped_free_slots = 0;
+};
+
+// Statistics policies are given as last template parameter of genex
+// containers. Their member functions are called on the hot paths of the
+// containers, hence the default one does nothing and takes no space.
+//
+// The member functions are const because they are also called by const member
+// functions of the containers, such as get() const and cbegin().
+struct no_statistics {
+    static constexpr bool enabled = false;
+
+    constexpr void on_get(bool /*success*/) const noexcept {}
+    constexpr void on_emplace_in_free_slot() const noexcept {}
+    constexpr void on_emplace_at_back(bool /*reallocated*/) const noexcept {}
+    constexpr void on_remove(bool /*success*/) const noexcept {}
+    constexpr void on_iteration_skip() const noexcept {}
+
+    gic_statistics snapshot() const noexcept {
+        return {};
+    }
+
+    void reset() noexcept {}
+};
+
+// Counts every event. Since it is updated by const member functions of the
+// container, it is no more thread-safe than the container's non-const member
+// functions.
+class counting_statistics {
+public:
+    static constexpr bool enabled = true;
+
+    void on_get(bool success) const noexcept {
+        ++(success ? counters.successful_gets : counters.failed_gets);
+    }
+
+    void on_emplace_in_free_slot() const noexcept {
+        ++counters.emplacements_in_free_slots;
+    }
+
+    void on_emplace_at_back(bool reallocated) const noexcept {
+        ++counters.emplacements_at_back;
+        if(reallocated) {
+            ++counters.reallocations;
+        }
+    }
+
+    void on_remove(bool success) const noexcept {
+        ++(success ? counters.removals : counters.failed_removals);
+    }
+
+    void on_iteration_skip() const noexcept {
+        ++counters.skipped_free_slots;
+    }
+
+    gic_statistics snapshot() const noexcept {
+        return counters;
+    }
+
+    void reset() noexcept {
+        counters = {};
+    }
+
+private:
+    mutable gic_statistics counters;
+};
+
+} // end namespace genex
+
+#endif // GIC_STATISTICS_HPP
@@ -0,0 +1,303 @@
+#ifndef SYSTEM_SCHEDULER_HPP
+#define SYSTEM_SCHEDULER_HPP
+
+#include <algorithm>
+#include <cassert>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace genex {
+
+// The containers a system reads or writes, by address: declaring them is all
+// the scheduler knows about a system.
+struct read_set {
+    std::vector<void const*> containers;
+};
+
+struct write_set {
+    std::vector<void const*> containers;
+};
+
+template<class... Containers>
+read_set reads(Containers const&... containers) {
+    return {{static_cast<void const*>(std::addressof(containers))...}};
+}
+
+template<class... Containers>
+write_set writes(Containers const&... containers) {
+    return {{static_cast<void const*>(std::addressof(containers))...}};
+}
+
+// Runs the systems of a tick, functions over genex containers, on a pool of
+// threads. Two systems conflict when one of them writes a container the other
+// one reads or writes; conflicting systems run in the order they were added,
+// the others run concurrently.
+//
+// A partitioned system is split into tasks over ranges of the slots of its
+// container, which run concurrently. It writes its container, but may only
+// modify the elements it is given: emplacing or removing elements during the
+// tick is for the other systems.
+//
+// Systems may not be added during run(), e.g. by a system: the worker
+// threads refer to the systems without holding the lock.
+//
+// Tasks are handed out from a single queue rather than stolen from
+// per-thread queues: partitioned systems are cut into a few times more ranges
+// than there are threads, so that threads that finish early take the
+// remaining ones.
+class system_scheduler {
+public:
+    explicit system_scheduler(
+            std::size_t thread_count = std::thread::hardware_concurrency())
+    {
+        thread_count = std::max<std::size_t>(thread_count, 1);
+        threads.reserve(thread_count);
+        for(std::size_t i = 0; i < thread_count; ++i) {
+            threads.emplace_back([this] { work(); });
+        }
+    }
+
+    system_scheduler(system_scheduler const&) = delete;
+    system_scheduler& operator=(system_scheduler const&) = delete;
+
+    ~system_scheduler() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        work_available.notify_all();
+        for(auto& thread : threads) {
+            thread.join();
+        }
+    }
+
+    [[nodiscard]] std::size_t thread_count() const noexcept {
+        return threads.size();
+    }
+
+    // Adds a system calling f(), and returns its index.
+    template<typename F>
+    std::size_t add_system(F&& f, read_set r = {}, write_set w = {}) {
+        system s;
+        s.body = std::forward<F>(f);
+        return add(std::move(s), std::move(r), std::move(w));
+    }
+
+    template<typename F>
+    std::size_t add_system(F&& f, write_set w) {
+        return add_system(std::forward<F>(f), read_set{}, std::move(w));
+    }
+
+    // Adds a system calling f(key, element) on every element of container,
+    // split into ranges of slots that run concurrently, and returns its index.
+    // f is shared by the ranges, hence called concurrently.
+    template<class Gic, typename F>
+    std::size_t add_partitioned_system(Gic& container,
+                                       F&& f,
+                                       read_set r = {})
+    {
+        system s;
+        s.slots = [&container] { return container.slots(); };
+        s.range_body = [&container, f = std::forward<F>(f)](
+                std::size_t first, std::size_t last) {
+            container.for_each_in_slots(first, last, f);
+        };
+        return add(std::move(s), std::move(r), writes(container));
+    }
+
+    // Runs every system once, and returns when they are all done. If systems
+    // throw, the systems that were not started yet are skipped and the first
+    // exception is rethrown.
+    void run() {
+        std::unique_lock<std::mutex> lock(mutex);
+        if(systems.empty()) {
+            return;
+        }
+
+        running = true;
+        remaining = systems.size();
+        error = nullptr;
+        for(auto& s : systems) {
+            s.pending = s.dependencies;
+        }
+        // Not pending == 0: a system that finishes as soon as it starts, e.g.
+        // a partitioned one over an empty container, already started its
+        // dependents.
+        for(std::size_t i = 0; i < systems.size(); ++i) {
+            if(systems[i].dependencies == 0) {
+                start(i);
+            }
+        }
+
+        tick_done.wait(lock, [this] { return remaining == 0; });
+        running = false;
+
+        if(error) {
+            std::rethrow_exception(std::exchange(error, nullptr));
+        }
+    }
+
+private:
+    struct system {
+        std::function<void()> body;
+        std::function<std::size_t()> slots;
+        std::function<void(std::size_t, std::size_t)> range_body;
+
+        std::vector<void const*> reads;
+        std::vector<void const*> writes;
+        std::vector<std::size_t> dependents;
+        std::size_t dependencies = 0;
+
+        // state of the current tick
+        std::size_t pending = 0;
+        std::size_t unfinished_ranges = 0;
+    };
+
+    struct task {
+        std::size_t system;
+        std::size_t first;
+        std::size_t last;
+    };
+
+    std::vector<system> systems;
+    std::vector<std::thread> threads;
+
+    std::mutex mutex;
+    std::condition_variable work_available;
+    std::condition_variable tick_done;
+    std::deque<task> tasks;
+    std::size_t remaining = 0;
+    std::exception_ptr error;
+    bool running = false;
+    bool stopping = false;
+
+    static constexpr std::size_t ranges_per_thread = 4;
+
+    static bool intersect(std::vector<void const*> const& a,
+                          std::vector<void const*> const& b) {
+        return std::any_of(a.begin(), a.end(), [&](void const* c) {
+            return std::find(b.begin(), b.end(), c) != b.end();
+        });
+    }
+
+    static bool conflict(system const& a, system const& b) {
+        return intersect(a.writes, b.writes) ||
+               intersect(a.writes, b.reads) ||
+               intersect(a.reads, b.writes);
+    }
+
+    std::size_t add(system s, read_set r, write_set w) {
+        std::lock_guard<std::mutex> lock(mutex);
+        assert(!running);
+
+        s.reads = std::move(r.containers);
+        s.writes = std::move(w.containers);
+
+        auto const idx = systems.size();
+        for(std::size_t i = 0; i < idx; ++i) {
+            if(conflict(systems[i], s)) {
+                systems[i].dependents.push_back(idx);
+                ++s.dependencies;
+            }
+        }
+
+        systems.push_back(std::move(s));
+        return idx;
+    }
+
+    // Both called with the mutex locked.
+
+    void start(std::size_t idx) {
+        auto& s = systems[idx];
+        if(!s.slots) {
+            tasks.push_back({idx, 0, 0});
+            work_available.notify_one();
+            return;
+        }
+
+        // No system that modifies the container runs concurrently, since this
+        // one writes it.
+        auto const slot_count = s.slots();
+        auto const parts = threads.size() * ranges_per_thread;
+        auto const range = std::max<std::size_t>(
+            (slot_count + parts - 1) / parts, 1);
+
+        s.unfinished_ranges = 0;
+        for(std::size_t first = 0; first < slot_count; first += range) {
+            tasks.push_back({idx, first, std::min(first + range, slot_count)});
+            ++s.unfinished_ranges;
+        }
+
+        if(s.unfinished_ranges == 0) {
+            finish(idx);
+        }
+        else {
+            work_available.notify_all();
+        }
+    }
+
+    void finish(std::size_t idx) {
+        for(auto dependent : systems[idx].dependents) {
+            if(--systems[dependent].pending == 0) {
+                start(dependent);
+            }
+        }
+
+        if(--remaining == 0) {
+            tick_done.notify_all();
+        }
+    }
+
+    void work() {
+        std::unique_lock<std::mutex> lock(mutex);
+        for(;;) {
+            work_available.wait(lock, [this] {
+                return stopping || !tasks.empty();
+            });
+            if(tasks.empty()) {
+                return;
+            }
+
+            auto t = tasks.front();
+            tasks.pop_front();
+            auto& s = systems[t.system];
+            bool const skipped = static_cast<bool>(error);
+
+            lock.unlock();
+            try {
+                if(!skipped) {
+                    if(s.range_body) {
+                        s.range_body(t.first, t.last);
+                    }
+                    else {
+                        s.body();
+                    }
+                }
+            }
+            catch(...) {
+                lock.lock();
+                if(!error) {
+                    error = std::current_exception();
+                }
+                lock.unlock();
+            }
+            lock.lock();
+
+            if(!s.range_body || --s.unfinished_ranges == 0) {
+                finish(t.system);
+            }
+        }
+    }
+};
+
+} // end namespace genex
+
+#endif // SYSTEM_SCHEDULER_HPP
@@ -2,6 +2,8 @@
 #define BOOST_TEST_DYN_LINK
 #endif
 #include <memory>
+#include <string>
+#include <vector>
 #include <boost/test/unit_test.hpp>
 #include "generic_test_definitions.hpp"
 #include "../zero_on_destruction.hpp"
@@ -132,3 +134,193 @@ BOOST_AUTO_TEST_CASE( destruction_on_emplacement ) {
 
     BOOST_TEST(val == 0);
 }
+
+
+// ===== Access without boost::optional =====
+
+BOOST_FIXTURE_TEST_CASE( get_ptr, GicWithOneElementFixture ) {
+    int* ptr = container.get_ptr(key);
+
+    BOOST_TEST(ptr != nullptr);
+    BOOST_TEST(*ptr == NON_ZERO_VAL);
+    BOOST_TEST(ptr == std::addressof(*container.get(key)));
+}
+
+BOOST_FIXTURE_TEST_CASE( get_ptr_const, GicWithOneElementFixture ) {
+    int const* ptr = std::as_const(container).get_ptr(key);
+
+    BOOST_TEST(ptr != nullptr);
+    BOOST_TEST(*ptr == NON_ZERO_VAL);
+}
+
+BOOST_FIXTURE_TEST_CASE( get_ptr_removed, GicWithOneElementFixture ) {
+    container.remove(key);
+
+    BOOST_TEST(container.get_ptr(key) == nullptr);
+}
+
+BOOST_FIXTURE_TEST_CASE( visit_present, GicWithOneElementFixture ) {
+    bool const visited = container.visit(key, [](int& v) {
+        v = NON_ZERO_VAL_2;
+    });
+
+    BOOST_TEST(visited);
+    BOOST_TEST(*container[key] == NON_ZERO_VAL_2);
+}
+
+BOOST_FIXTURE_TEST_CASE( visit_removed, GicWithOneElementFixture ) {
+    container.remove(key);
+    int calls = 0;
+    bool const visited = std::as_const(container).visit(key, [&](int const&) {
+        ++calls;
+    });
+
+    BOOST_TEST(!visited);
+    BOOST_TEST(calls == 0);
+}
+
+BOOST_FIXTURE_TEST_CASE( get_unchecked, GicWithOneElementFixture ) {
+    BOOST_TEST(container.get_unchecked(key) == NON_ZERO_VAL);
+    BOOST_TEST(std::as_const(container).get_unchecked(key) == NON_ZERO_VAL);
+}
+
+
+// ===== Copy =====
+
+BOOST_FIXTURE_TEST_CASE( copy_keeps_keys, GicWithOneElementFixture ) {
+    gic_type copy(container);
+
+    BOOST_TEST(*copy[key] == NON_ZERO_VAL);
+    BOOST_TEST(std::addressof(*copy[key]) != std::addressof(*container[key]));
+}
+
+BOOST_FIXTURE_TEST_CASE( copy_is_independent, GicWithOneElementFixture ) {
+    gic_type copy = container.clone();
+    *copy[key] = NON_ZERO_VAL_2;
+    copy.remove(key);
+
+    BOOST_TEST(*container[key] == NON_ZERO_VAL);
+}
+
+BOOST_FIXTURE_TEST_CASE( copy_keeps_free_slots, GicFixture ) {
+    auto kept_key = container.emplace(NON_ZERO_VAL_1);
+    auto free_key = container.emplace(NON_ZERO_VAL);
+    container.remove(free_key);
+
+    gic_type copy;
+    copy = container;
+    auto new_key = copy.emplace(NON_ZERO_VAL_2);
+
+    BOOST_TEST(new_key.get_index() == free_key.get_index());
+    BOOST_TEST((copy[free_key] == copy.failed_get()));
+    BOOST_TEST(*copy[kept_key] == NON_ZERO_VAL_1);
+    BOOST_TEST(*copy[new_key] == NON_ZERO_VAL_2);
+}
+
+BOOST_AUTO_TEST_CASE( copy_constructs_only_living_objects ) {
+    int val_a = NON_ZERO_VAL;
+    int val_b = NON_ZERO_VAL;
+
+    {
+        gic_derived<zero_on_destruction<int>> container;
+        auto key_a = container.emplace(val_a);
+        (void)container.emplace(val_b);
+        container.remove(key_a);
+        val_a = NON_ZERO_VAL;
+
+        auto copy = container.clone();
+        container.remove(key_a);
+    }
+
+    // the free slot of the copy would have been destroyed too otherwise
+    BOOST_TEST(val_a == NON_ZERO_VAL);
+    BOOST_TEST(val_b == 0);
+}
+
+BOOST_FIXTURE_TEST_CASE( move_keeps_keys, GicWithOneElementFixture ) {
+    gic_type moved(std::move(container));
+
+    BOOST_TEST(*moved[key] == NON_ZERO_VAL);
+}
+
+
+// ===== Non-trivial types =====
+
+BOOST_AUTO_TEST_CASE( non_trivially_relocatable_growth ) {
+    // Every other string is long enough not to fit in the small string
+    // buffer. The short ones point into themselves and break if their bytes
+    // are copied.
+    auto const make_val = [](int i) {
+        return i % 2 == 0 ? std::string(32, 'a') + std::to_string(i)
+                          : std::to_string(i);
+    };
+
+    gic_derived<std::string> container;
+    std::vector<typename gic_derived<std::string>::key_type> keys;
+    for(int i = 0; i < 100; ++i) {
+        keys.push_back(container.emplace(make_val(i)));
+        if(i % 3 == 0) {
+            container.remove(keys[i]);
+        }
+    }
+
+    auto copy = container;
+    for(int i = 0; i < 100; ++i) {
+        if(i % 3 == 0) {
+            BOOST_TEST(container.get_ptr(keys[i]) == nullptr);
+        }
+        else {
+            BOOST_TEST(*container[keys[i]] == make_val(i));
+            BOOST_TEST(*copy[keys[i]] == make_val(i));
+        }
+    }
+}
+
+
+// ===== Incremental passes =====
+
+BOOST_FIXTURE_TEST_CASE( advance_processes_budgeted_elements, GicFixture ) {
+    std::vector<gic_type::key_type> keys;
+    for(int i = 0; i < 10; ++i) {
+        keys.push_back(container.emplace(i));
+    }
+    container.remove(keys[1]);
+
+    gic_cursor cursor;
+    std::vector<int> seen;
+    auto const collect = [&](gic_type::key_type const& k, int& value) {
+        BOOST_TEST(*container[k] == value);
+        seen.push_back(value);
+    };
+
+    BOOST_TEST(container.advance(cursor, 3, collect) == 3u);
+    BOOST_TEST(seen == (std::vector<int>{0, 2, 3}));
+
+    // changes between two steps of the pass
+    (void)container.emplace(10); // in the only free slot, already passed
+    (void)container.emplace(11); // appended
+    container.remove(keys[4]);
+    container.remove(keys[2]);
+
+    BOOST_TEST(container.advance(cursor, 100, collect) == 6u);
+    BOOST_TEST(seen == (std::vector<int>{0, 2, 3, 5, 6, 7, 8, 9, 11}));
+    BOOST_TEST(container.advance(cursor, 100, collect) == 0u);
+
+    cursor.reset();
+    BOOST_TEST(container.advance(cursor, 100, collect) == 9u);
+}
+
+BOOST_FIXTURE_TEST_CASE( advance_tolerates_removal_of_current, GicFixture ) {
+    for(int i = 0; i < 4; ++i) {
+        (void)container.emplace(i);
+    }
+
+    gic_cursor cursor;
+    auto const remove_evens = [&](gic_type::key_type const& k, int& value) {
+        if(value % 2 == 0) {
+            container.remove(k);
+        }
+    };
+    BOOST_TEST(container.advance(cursor, 4, remove_evens) == 4u);
+    BOOST_TEST(std::distance(container.begin(), container.end()) == 2);
+}
@@ -3,6 +3,8 @@
 #endif
 #include <boost/test/unit_test.hpp>
 #include <utility>
+#include <vector>
+#include <iterator>
 #include <algorithm>
 #include <type_traits>
 #include "generic_test_definitions.hpp"
@@ -175,6 +177,32 @@ BOOST_FIXTURE_TEST_CASE( iterator_multipass_equality, GicWithOneElementFixture )
     ASSERT_TRUE(++ita == ++itb);
 }
 
+BOOST_FIXTURE_TEST_CASE( iterator_incr_at_end_stays_at_end,
+                         GicWithOneElementFixture )
+{
+    auto it = container.end();
+    ++it;
+    ASSERT_TRUE(it == container.end());
+}
+
+BOOST_FIXTURE_TEST_CASE( iterator_compares_to_end_sentinel,
+                         GicWithOneElementFixture )
+{
+    auto it = container.begin();
+    ASSERT_TRUE(it != genex::end_sentinel);
+    ++it;
+    ASSERT_TRUE(it == genex::end_sentinel);
+    ASSERT_TRUE(genex::end_sentinel == container.cend());
+}
+
+BOOST_AUTO_TEST_CASE( iterator_is_small ) {
+    // a position and an end bound, plus a position among the objects for
+    // containers that store them apart from the generations
+    static_assert(sizeof(gic_derived<int>::iterator) <= 3 * sizeof(void*));
+    static_assert(sizeof(gic_derived<int>::const_iterator) <=
+                  3 * sizeof(void*));
+}
+
 BOOST_FIXTURE_TEST_CASE( iterator_multipass_untied_copy,
                          GicWithOneElementFixture )
 {
@@ -210,5 +238,19 @@ BOOST_FIXTURE_TEST_CASE( iterator_post_decrement, GicWithOneElementFixture ) {
     BOOST_TEST(*it == NON_ZERO_VAL);
 }
 
+BOOST_FIXTURE_TEST_CASE( iterate_backwards_from_end, GicFixture ) {
+    // Three elements leave unused capacity after the last one.
+    (void)container.emplace(1);
+    (void)container.emplace(2);
+    (void)container.emplace(3);
+
+    BOOST_TEST(*--container.end() == 3);
+    BOOST_TEST(*--std::as_const(container).end() == 3);
+
+    std::vector<int> reversed(std::make_reverse_iterator(container.end()),
+                              std::make_reverse_iterator(container.begin()));
+    BOOST_TEST((reversed == std::vector<int>{3, 2, 1}));
+}
+
 
 // GIC iterators cannot be random-access-iterators
@@ -22,6 +22,22 @@ BOOST_AUTO_TEST_SUITE( gic_fast_iterable_tests )
 #include "generic/gic_base_tests.hpp"
 #include "generic/gic_iterator_tests.hpp"
 
+BOOST_AUTO_TEST_CASE( for_each_run_yields_single_elements ) {
+    gic_derived<int> container;
+    std::vector<key<int>> keys;
+    for(int i = 0; i < 5; ++i) {
+        keys.push_back(container.emplace(i));
+    }
+    container.remove(keys[2]);
+
+    std::vector<int> seen;
+    container.for_each_run([&](element_run<int> run) {
+        BOOST_TEST(run.size == 1u);
+        seen.push_back(*run.data);
+    });
+    BOOST_TEST((seen == std::vector<int>{0, 1, 3, 4}));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 
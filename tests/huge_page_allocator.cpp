@@ -0,0 +1,55 @@
+#ifndef BOOST_TEST_DYN_LINK
+#define BOOST_TEST_DYN_LINK
+#endif
+#include <boost/test/unit_test.hpp>
+#include <cstdint>
+#include <huge_page_allocator.hpp>
+using namespace boost::unit_test;
+
+using namespace genex;
+
+template<typename T>
+using gic_derived = huge_page_split_gic<T>;
+#define OUTER_GIC_TEST
+
+BOOST_AUTO_TEST_SUITE( huge_page_allocator_tests )
+
+#include "generic/gic_base_tests.hpp"
+#include "generic/gic_iterator_tests.hpp"
+
+BOOST_AUTO_TEST_CASE( big_allocations_are_aligned_on_huge_pages ) {
+    huge_page_allocator<double> allocator;
+    auto const n = huge_page_size / sizeof(double) + 1;
+    double* p = allocator.allocate(n);
+    BOOST_TEST(reinterpret_cast<std::uintptr_t>(p) % huge_page_size == 0u);
+    p[0] = 1.0;
+    p[n - 1] = 2.0;
+    allocator.deallocate(p, n);
+
+    double* small = allocator.allocate(3);
+    small[2] = 3.0;
+    allocator.deallocate(small, 3);
+}
+
+BOOST_AUTO_TEST_CASE( prefaulted_container_grows ) {
+    huge_page_split_gic<int, key<int>, prefaulted_huge_page_vector> container;
+    std::vector<key<int>> keys;
+    for(int i = 0; i < 1 << 20; ++i) {
+        keys.push_back(container.emplace(i));
+    }
+    BOOST_TEST(*container[keys.back()] == (1 << 20) - 1);
+    BOOST_TEST(container.memory_usage().objects.allocated_bytes >=
+               huge_page_size);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+
+static bool empty_init() {
+    return true;
+}
+
+int main(int argc, char* argv[], char* envp[]) {
+    (void)envp;
+    return ::boost::unit_test::unit_test_main( &empty_init, argc, argv );
+}
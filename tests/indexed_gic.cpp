@@ -0,0 +1,178 @@
+#ifndef BOOST_TEST_DYN_LINK
+#define BOOST_TEST_DYN_LINK
+#endif
+#include <boost/test/unit_test.hpp>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <indexed_gic.hpp>
+#include <split_gic.hpp>
+using namespace boost::unit_test;
+
+using namespace genex;
+
+struct unit {
+    std::string name;
+    int owner;
+};
+
+static auto make_units() {
+    return make_indexed_gic<split_gic<unit>>(
+        hashed_index{&unit::name},
+        ordered_index{[](unit const& u) { return u.owner; }});
+}
+
+BOOST_AUTO_TEST_SUITE( indexed_gic_tests )
+
+BOOST_AUTO_TEST_CASE( lookup_by_attribute ) {
+    auto units = make_units();
+    auto a = units.emplace(unit{"archer", 1});
+    auto b = units.emplace(unit{"knight", 2});
+    auto c = units.emplace(unit{"scout", 2});
+
+    BOOST_TEST((units.find<0>("knight") == b));
+    BOOST_TEST(!units.find<0>("wizard"));
+    BOOST_TEST(units[a]->name == "archer");
+
+    auto [first, last] = units.equal_range<1>(2);
+    BOOST_TEST(std::distance(first, last) == 2);
+    for(; first != last; ++first) {
+        BOOST_TEST((first->second == b || first->second == c));
+    }
+
+    // range query on the ordered index
+    auto const& by_owner = units.index<1>();
+    BOOST_TEST(std::distance(by_owner.lower_bound(2), by_owner.end()) == 2);
+}
+
+BOOST_AUTO_TEST_CASE( removal_updates_the_indexes ) {
+    auto units = make_units();
+    auto a = units.emplace(unit{"archer", 1});
+    units.remove(a);
+
+    BOOST_TEST(!units.is_present(a));
+    BOOST_TEST(!units.find<0>("archer"));
+    BOOST_TEST(units.index<1>().empty());
+
+    // removing twice does nothing
+    units.remove(a);
+}
+
+BOOST_AUTO_TEST_CASE( modifier_reindexes_on_destruction ) {
+    auto units = make_units();
+    auto a = units.emplace(unit{"archer", 1});
+
+    {
+        auto m = units.modify(a);
+        BOOST_TEST(static_cast<bool>(m));
+        m->name = "longbowman";
+        m->owner = 3;
+
+        // out of the indexes while modified
+        BOOST_TEST(!units.find<0>("archer"));
+        BOOST_TEST(!units.find<0>("longbowman"));
+    }
+
+    BOOST_TEST(!units.find<0>("archer"));
+    BOOST_TEST((units.find<0>("longbowman") == a));
+    BOOST_TEST(units.index<1>().count(1) == 0u);
+    BOOST_TEST((units.find<1>(3) == a));
+
+    BOOST_TEST(units.modify(a, [](unit& u) { u.owner = 4; }));
+    BOOST_TEST((units.find<1>(4) == a));
+
+    units.remove(a);
+    BOOST_TEST(!units.modify(a));
+    BOOST_TEST(!units.modify(a, [](unit&) {}));
+}
+
+BOOST_AUTO_TEST_CASE( commit_reindexes_before_destruction ) {
+    auto units = make_units();
+    auto a = units.emplace(unit{"archer", 1});
+
+    auto m = units.modify(a);
+    m->owner = 2;
+    m.commit();
+    BOOST_TEST((units.find<1>(2) == a));
+
+    // nothing left to do for the destructor
+    m.commit();
+    BOOST_TEST(units.index<1>().size() == 1u);
+}
+
+BOOST_AUTO_TEST_CASE( failed_reindexing_removes_the_element ) {
+    auto units = make_indexed_gic<split_gic<unit>>(
+        hashed_index{&unit::name},
+        ordered_index{[](unit const& u) {
+            if(u.owner < 0) {
+                throw std::invalid_argument("no owner");
+            }
+            return u.owner;
+        }});
+    auto a = units.emplace(unit{"archer", 1});
+    auto b = units.emplace(unit{"knight", 2});
+
+    auto m = units.modify(a);
+    m->owner = -1;
+    BOOST_CHECK_THROW(m.commit(), std::invalid_argument);
+    BOOST_TEST(!units.is_present(a));
+    BOOST_TEST(!units.find<0>("archer"));
+
+    // the destructor swallows the exception
+    {
+        auto n = units.modify(b);
+        n->owner = -1;
+    }
+    BOOST_TEST(!units.is_present(b));
+    BOOST_TEST(units.index<0>().empty());
+    BOOST_TEST(units.index<1>().empty());
+}
+
+BOOST_AUTO_TEST_CASE( entries_are_found_after_rehashing ) {
+    auto units = make_units();
+    std::vector<key<unit>> keys;
+    for(int i = 0; i < 1000; ++i) {
+        // every element has the same owner and one of a few names
+        keys.push_back(units.emplace(unit{std::to_string(i % 7), 0}));
+    }
+
+    for(int i = 0; i < 1000; i += 2) {
+        units.modify(keys[i], [i](unit& u) { u.name = std::to_string(i); });
+    }
+    for(int i = 1; i < 1000; i += 2) {
+        units.remove(keys[i]);
+    }
+
+    BOOST_TEST(units.index<0>().size() == 500u);
+    BOOST_TEST(units.index<1>().size() == 500u);
+    for(int i = 0; i < 1000; i += 2) {
+        BOOST_TEST((units.find<0>(std::to_string(i)) == keys[i]));
+    }
+}
+
+BOOST_AUTO_TEST_CASE( iteration_is_const ) {
+    auto units = make_units();
+    (void)units.emplace(unit{"archer", 1});
+    (void)units.emplace(unit{"knight", 2});
+
+    int owners = 0;
+    for(auto const& u : units) {
+        owners += u.owner;
+    }
+    BOOST_TEST(owners == 3);
+    BOOST_TEST(std::distance(units.container().begin(),
+                             units.container().end()) == 2);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+
+static bool empty_init() {
+    return true;
+}
+
+int main(int argc, char* argv[], char* envp[]) {
+    (void)envp;
+    return ::boost::unit_test::unit_test_main( &empty_init, argc, argv );
+}
@@ -0,0 +1,48 @@
+#ifndef BOOST_TEST_DYN_LINK
+#define BOOST_TEST_DYN_LINK
+#endif
+#include <boost/test/unit_test.hpp>
+#include <vector>
+#include <interleaved_gic.hpp>
+using namespace boost::unit_test;
+
+using namespace genex;
+
+template<typename... Args>
+using gic_derived = interleaved_gic<Args...>;
+#define OUTER_GIC_TEST
+
+BOOST_AUTO_TEST_SUITE( interleaved_gic_tests )
+
+#include "generic/gic_base_tests.hpp"
+#include "generic/gic_iterator_tests.hpp"
+
+BOOST_AUTO_TEST_CASE( slot_alignment ) {
+    using cache_line_gic = interleaved_gic<
+        int,
+        std::vector,
+        key<int>,
+        std::vector<std::size_t>,
+        64>;
+
+    static_assert(sizeof(cache_line_gic::slot_type) == 64);
+    static_assert(alignof(cache_line_gic::slot_type) == 64);
+    static_assert(sizeof(interleaved_gic<int>::slot_type) ==
+                  2 * sizeof(std::size_t));
+
+    cache_line_gic container;
+    auto key = container.emplace(NON_ZERO_VAL);
+    BOOST_TEST(*container[key] == NON_ZERO_VAL);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+
+static bool empty_init() {
+    return true;
+}
+
+int main(int argc, char* argv[], char* envp[]) {
+    (void)envp;
+    return ::boost::unit_test::unit_test_main( &empty_init, argc, argv );
+}
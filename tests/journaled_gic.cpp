@@ -0,0 +1,197 @@
+#ifndef BOOST_TEST_DYN_LINK
+#define BOOST_TEST_DYN_LINK
+#endif
+#include <boost/test/unit_test.hpp>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <gic_fit.hpp>
+#include <journaled_gic.hpp>
+#include <split_gic.hpp>
+using namespace boost::unit_test;
+
+using namespace genex;
+
+struct string_codec {
+    void encode(std::string const& s, std::vector<char>& out) const {
+        out.insert(out.end(), s.begin(), s.end());
+    }
+
+    std::string decode(char const* data, std::size_t size) const {
+        return {data, size};
+    }
+};
+
+BOOST_AUTO_TEST_SUITE( journaled_gic_tests )
+
+BOOST_AUTO_TEST_CASE( replay_rebuilds_the_same_keys ) {
+    using gic = split_gic<int>;
+    std::stringstream journal;
+    std::vector<key<int>> keys;
+
+    {
+        journaled_gic<gic> container(journal);
+        for(int i = 0; i < 10; ++i) {
+            keys.push_back(container.emplace(i));
+        }
+        container.remove(keys[3]);
+        container.remove(keys[7]);
+        keys.push_back(container.emplace(30));
+        BOOST_TEST(container.modify(keys[0], [](int& x) { x = -1; }));
+        container.remove(keys[1]);
+    }
+
+    gic replayed;
+    BOOST_TEST(journaled_gic<gic>::replay(journal, replayed) == 15u);
+
+    BOOST_TEST(*replayed[keys[0]] == -1);
+    BOOST_TEST(!replayed.is_present(keys[1]));
+    BOOST_TEST(*replayed[keys[2]] == 2);
+    BOOST_TEST(!replayed.is_present(keys[3]));
+    BOOST_TEST(!replayed.is_present(keys[7]));
+    BOOST_TEST(*replayed[keys[10]] == 30);
+    BOOST_TEST(std::distance(replayed.begin(), replayed.end()) == 8);
+}
+
+BOOST_AUTO_TEST_CASE( replay_on_a_snapshot_with_a_codec ) {
+    using gic = gic_fit<std::string,
+                        std::vector,
+                        key<std::string>,
+                        std::vector<std::size_t>>;
+    gic snapshot;
+    auto kept = snapshot.emplace("kept");
+
+    using journaled = journaled_gic<gic, string_codec>;
+
+    std::stringstream journal;
+    journaled container(journal, snapshot);
+    auto added = container.emplace("added");
+    container.modify(kept, [](std::string& s) { s += "!"; });
+    container.flush();
+
+    gic replayed = snapshot;
+    BOOST_TEST(journaled::replay(journal, replayed) == 2u);
+    BOOST_TEST(*replayed[kept] == "kept!");
+    BOOST_TEST(*replayed[added] == "added");
+}
+
+BOOST_AUTO_TEST_CASE( replay_the_tail_on_a_copy_with_an_intrusive_free_list ) {
+    using gic = split_gic<std::string,
+                          std::vector,
+                          key<std::string>,
+                          intrusive_free_list>;
+    using journaled = journaled_gic<gic, string_codec>;
+
+    std::stringstream journal;
+    journaled container(journal);
+    auto first = container.emplace("first");
+    auto second = container.emplace("second");
+    auto third = container.emplace("third");
+    container.remove(first);
+    container.remove(third);
+    container.flush();
+
+    // the free slots are reused last freed first, by the copy too
+    gic snapshot = container.container();
+    auto const snapshot_end = journal.str().size();
+    auto fourth = container.emplace("fourth");
+    auto fifth = container.emplace("fifth");
+    container.flush();
+    BOOST_TEST(fourth.get_index() == third.get_index());
+    BOOST_TEST(fifth.get_index() == first.get_index());
+
+    std::istringstream tail(journal.str().substr(snapshot_end));
+    BOOST_TEST(journaled::replay(tail, snapshot) == 2u);
+    BOOST_TEST(*snapshot[second] == "second");
+    BOOST_TEST(*snapshot[fourth] == "fourth");
+    BOOST_TEST(*snapshot[fifth] == "fifth");
+}
+
+BOOST_AUTO_TEST_CASE( replay_stops_at_a_cut_record ) {
+    using gic = split_gic<double>;
+    std::stringstream journal;
+    {
+        journaled_gic<gic> container(journal);
+        (void)container.emplace(1.0);
+        (void)container.emplace(2.0);
+    }
+
+    auto bytes = journal.str();
+    std::stringstream cut(bytes.substr(0, bytes.size() - 3));
+
+    gic replayed;
+    BOOST_TEST(journaled_gic<gic>::replay(cut, replayed) == 1u);
+    BOOST_TEST(std::distance(replayed.begin(), replayed.end()) == 1);
+}
+
+BOOST_AUTO_TEST_CASE( replay_on_another_state_throws ) {
+    using gic = split_gic<int>;
+    std::stringstream journal;
+    {
+        journaled_gic<gic> container(journal);
+        (void)container.emplace(1);
+    }
+
+    gic other;
+    (void)other.emplace(0);
+    BOOST_CHECK_THROW(journaled_gic<gic>::replay(journal, other),
+                      std::runtime_error);
+}
+
+// refuses to encode negative numbers
+struct picky_codec {
+    void encode(int const& x, std::vector<char>& out) const {
+        if(x < 0) {
+            throw std::invalid_argument("negative");
+        }
+        trivial_codec<int>{}.encode(x, out);
+    }
+
+    int decode(char const* data, std::size_t size) const {
+        return trivial_codec<int>{}.decode(data, size);
+    }
+};
+
+BOOST_AUTO_TEST_CASE( failures_leave_the_container_as_journaled ) {
+    using gic = split_gic<int>;
+    using journaled = journaled_gic<gic, picky_codec>;
+    std::stringstream journal;
+    key<int> a{0, 0};
+    key<int> b{0, 0};
+
+    {
+        journaled container(journal);
+        a = container.emplace(1);
+        BOOST_CHECK_THROW((void)container.emplace(-1), std::invalid_argument);
+        BOOST_TEST(std::distance(container.begin(), container.end()) == 1);
+
+        BOOST_CHECK_THROW(container.modify(a, [](int& x) { x = -2; }),
+                          std::invalid_argument);
+        BOOST_CHECK_THROW(container.modify(a, [](int& x) {
+                              x = 5;
+                              throw std::runtime_error("f failed");
+                          }),
+                          std::runtime_error);
+        BOOST_TEST(*container[a] == 1);
+
+        b = container.emplace(2);
+    }
+
+    gic replayed;
+    BOOST_TEST(journaled::replay(journal, replayed) == 2u);
+    BOOST_TEST(*replayed[a] == 1);
+    BOOST_TEST(*replayed[b] == 2);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+
+static bool empty_init() {
+    return true;
+}
+
+int main(int argc, char* argv[], char* envp[]) {
+    (void)envp;
+    return ::boost::unit_test::unit_test_main( &empty_init, argc, argv );
+}
@@ -0,0 +1,147 @@
+#ifndef BOOST_TEST_DYN_LINK
+#define BOOST_TEST_DYN_LINK
+#endif
+#include <boost/test/unit_test.hpp>
+#include <iterator>
+#include <vector>
+#include <key_set.hpp>
+#include <split_gic.hpp>
+using namespace boost::unit_test;
+
+using namespace genex;
+
+struct KeySetFixture {
+    using owner_type = split_gic<int>;
+    using key_type = owner_type::key_type;
+
+    KeySetFixture() {
+        for(int i = 0; i < 200; ++i) {
+            keys.push_back(owner.emplace(i));
+        }
+    }
+
+    owner_type owner;
+    std::vector<key_type> keys;
+};
+
+BOOST_AUTO_TEST_SUITE( key_set_tests )
+
+BOOST_FIXTURE_TEST_CASE( insert_contains_erase, KeySetFixture ) {
+    key_set<key_type> set;
+    BOOST_TEST(set.empty());
+
+    BOOST_TEST(set.insert(keys[3]));
+    BOOST_TEST(!set.insert(keys[3]));
+    BOOST_TEST(set.insert(keys[130]));
+    BOOST_TEST(set.contains(keys[3]));
+    BOOST_TEST(set.contains(keys[130]));
+    BOOST_TEST(!set.contains(keys[4]));
+    BOOST_TEST(set.size() == 2u);
+
+    set.erase(keys[3]);
+    BOOST_TEST(!set.contains(keys[3]));
+    BOOST_TEST(set.size() == 1u);
+
+    set.clear();
+    BOOST_TEST(set.empty());
+}
+
+BOOST_FIXTURE_TEST_CASE( stale_keys_are_rejected, KeySetFixture ) {
+    key_set<key_type> set;
+    set.insert(keys[5]);
+
+    owner.remove(keys[5]);
+    auto reused = owner.emplace(-5);
+    BOOST_TEST(reused.get_index() == keys[5].get_index());
+    BOOST_TEST(!set.contains(reused));
+
+    int count = 0;
+    set.for_each_in(owner, [&](int) { ++count; });
+    BOOST_TEST(count == 0);
+
+    set.erase_stale(owner);
+    BOOST_TEST(set.empty());
+}
+
+BOOST_FIXTURE_TEST_CASE( set_algebra, KeySetFixture ) {
+    key_set<key_type> evens;
+    key_set<key_type> thirds;
+    for(int i = 0; i < 200; ++i) {
+        if(i % 2 == 0) {
+            evens.insert(keys[i]);
+        }
+        if(i % 3 == 0) {
+            thirds.insert(keys[i]);
+        }
+    }
+
+    auto both = evens & thirds;
+    auto either = evens | thirds;
+    auto only_evens = evens - thirds;
+    for(int i = 0; i < 200; ++i) {
+        BOOST_TEST(both.contains(keys[i]) == (i % 6 == 0));
+        BOOST_TEST(either.contains(keys[i]) == (i % 2 == 0 || i % 3 == 0));
+        BOOST_TEST(only_evens.contains(keys[i]) == (i % 2 == 0 && i % 3 != 0));
+    }
+}
+
+BOOST_FIXTURE_TEST_CASE( algebra_combines_indexes, KeySetFixture ) {
+    key_set<key_type> old_set;
+    old_set.insert(keys[7]);
+
+    owner.remove(keys[7]);
+    auto reused = owner.emplace(-7);
+    key_set<key_type> new_set;
+    new_set.insert(reused);
+
+    // the stale key is read back as such
+    auto both = old_set & new_set;
+    BOOST_TEST(both.contains(keys[7]));
+    BOOST_TEST(!both.contains(reused));
+    int count = 0;
+    both.for_each_in(owner, [&](int) { ++count; });
+    BOOST_TEST(count == 0);
+
+    BOOST_TEST((old_set - new_set).empty());
+
+    // the key of the right operand is kept
+    auto merged = old_set | new_set;
+    BOOST_TEST(merged.contains(reused));
+    BOOST_TEST(!merged.contains(keys[7]));
+
+    old_set.erase_stale(owner);
+    BOOST_TEST((old_set & new_set).empty());
+    BOOST_TEST((new_set - old_set).contains(reused));
+}
+
+BOOST_FIXTURE_TEST_CASE( iteration_yields_keys_in_order, KeySetFixture ) {
+    key_set<key_type> set;
+    for(int i : {150, 0, 64, 63, 65}) {
+        set.insert(keys[i]);
+    }
+
+    std::vector<key_type> visited(set.begin(), set.end());
+    std::vector<key_type> expected{keys[0], keys[63], keys[64], keys[65],
+                                   keys[150]};
+    BOOST_TEST((visited == expected));
+    BOOST_TEST((std::next(set.begin(), 5) == end_sentinel));
+
+    int sum = 0;
+    set.for_each_in(owner, [&](int x) { sum += x; });
+    BOOST_TEST(sum == 150 + 0 + 64 + 63 + 65);
+
+    key_set<key_type> empty;
+    BOOST_TEST((empty.begin() == empty.end()));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+
+static bool empty_init() {
+    return true;
+}
+
+int main(int argc, char* argv[], char* envp[]) {
+    (void)envp;
+    return ::boost::unit_test::unit_test_main( &empty_init, argc, argv );
+}
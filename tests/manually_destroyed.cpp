@@ -46,6 +46,31 @@ BOOST_AUTO_TEST_CASE( emplacement_does_not_call_destructor ) {
     BOOST_TEST(val_a == 55);
 }
 
+BOOST_AUTO_TEST_CASE( default_construction_is_empty ) {
+    int val = 55;
+    {
+        manually_destructed<zero_on_destruction<int>> wrap;
+        wrap.emplace(val);
+    }
+    BOOST_TEST(val == 55);
+}
+
+BOOST_AUTO_TEST_CASE( trivially_copyable_when_object_is ) {
+    static_assert(std::is_trivially_copyable_v<manually_destructed<int>>);
+    static_assert(!std::is_trivially_copyable_v<
+                  manually_destructed<zero_on_destruction<int>>>);
+}
+
+BOOST_AUTO_TEST_CASE( not_copyable_unless_trivially_copyable ) {
+    static_assert(std::is_copy_constructible_v<manually_destructed<int>>);
+    static_assert(!std::is_copy_constructible_v<
+                  manually_destructed<zero_on_destruction<int>>>);
+    static_assert(!std::is_move_constructible_v<
+                  manually_destructed<zero_on_destruction<int>>>);
+    static_assert(!std::is_copy_assignable_v<
+                  manually_destructed<zero_on_destruction<int>>>);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 static bool empty_init() {
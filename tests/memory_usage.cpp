@@ -0,0 +1,80 @@
+#ifndef BOOST_TEST_DYN_LINK
+#define BOOST_TEST_DYN_LINK
+#endif
+#include <boost/test/unit_test.hpp>
+#include <cmath>
+#include <vector>
+#include <split_gic.hpp>
+#include <gic_fit.hpp>
+#include <memory_usage.hpp>
+using namespace boost::unit_test;
+
+using namespace genex;
+
+using fit = gic_fit<int, std::vector, key<int>, std::vector<std::size_t>>;
+
+BOOST_AUTO_TEST_SUITE( memory_usage_tests )
+
+BOOST_AUTO_TEST_CASE( empty_container_uses_nothing ) {
+    auto usage = split_gic<int>{}.memory_usage();
+    BOOST_TEST(usage.allocated_bytes() == 0u);
+    BOOST_TEST(usage.used_bytes() == 0u);
+    BOOST_TEST(usage.live_slots == 0u);
+    BOOST_TEST(usage.holes_per_live_slot() == 0.0);
+}
+
+BOOST_AUTO_TEST_CASE( split_gic_usage ) {
+    split_gic<int> container;
+    std::vector<key<int>> keys;
+    for(int i = 0; i < 10; ++i) {
+        keys.push_back(container.emplace(i));
+    }
+    container.remove(keys[2]);
+    container.remove(keys[3]);
+    container.remove(keys[4]);
+    container.remove(keys[7]);
+
+    auto usage = container.memory_usage();
+    BOOST_TEST(usage.live_slots == 6u);
+    BOOST_TEST(usage.free_slots == 4u);
+    BOOST_TEST(usage.longest_free_run == 3u);
+    BOOST_TEST(usage.holes_per_live_slot() == 4.0 / 6.0);
+
+    BOOST_TEST(usage.objects.used_bytes ==
+               10 * sizeof(split_gic<int>::wrapped_type));
+    BOOST_TEST(usage.objects.allocated_bytes >= usage.objects.used_bytes);
+    BOOST_TEST(usage.generations.used_bytes == 10 * sizeof(std::size_t));
+    BOOST_TEST(usage.free_indexes.used_bytes == 4 * sizeof(std::size_t));
+    BOOST_TEST(usage.used_bytes() ==
+               usage.objects.used_bytes +
+               usage.generations.used_bytes +
+               usage.free_indexes.used_bytes);
+}
+
+BOOST_AUTO_TEST_CASE( gic_fit_usage ) {
+    fit container;
+    auto k0 = container.emplace(0);
+    auto k1 = container.emplace(1);
+    container.remove(k0);
+    container.remove(k1);
+
+    auto usage = container.memory_usage();
+    BOOST_TEST(usage.live_slots == 0u);
+    BOOST_TEST(usage.free_slots == 2u);
+    BOOST_TEST(usage.longest_free_run == 2u);
+    BOOST_TEST(std::isinf(usage.holes_per_live_slot()));
+    BOOST_TEST(usage.objects.used_bytes == 2 * sizeof(fit::wrapped_type));
+    BOOST_TEST(usage.free_indexes.allocated_bytes == 0u);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+
+static bool empty_init() {
+    return true;
+}
+
+int main(int argc, char* argv[], char* envp[]) {
+    (void)envp;
+    return ::boost::unit_test::unit_test_main( &empty_init, argc, argv );
+}
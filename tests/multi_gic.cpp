@@ -0,0 +1,103 @@
+#ifndef BOOST_TEST_DYN_LINK
+#define BOOST_TEST_DYN_LINK
+#endif
+#include <boost/test/unit_test.hpp>
+#include <string>
+#include <multi_gic.hpp>
+using namespace boost::unit_test;
+
+using namespace genex;
+
+struct circle {
+    double radius;
+};
+
+struct square {
+    double side;
+};
+
+using shapes = multi_gic<circle, square, std::string>;
+
+BOOST_AUTO_TEST_SUITE( multi_gic_tests )
+
+BOOST_AUTO_TEST_CASE( keys_encode_their_type ) {
+    shapes container;
+    auto c = container.emplace<circle>(circle{1.0});
+    auto s = container.emplace<square>(square{2.0});
+    auto str = container.emplace<std::string>("three");
+
+    BOOST_TEST(shapes::type_of(c) == shapes::type_index<circle>);
+    BOOST_TEST(shapes::type_of(s) == shapes::type_index<square>);
+    BOOST_TEST(shapes::holds<std::string>(str));
+    BOOST_TEST(!shapes::holds<circle>(str));
+
+    BOOST_TEST(container.get<circle>(c)->radius == 1.0);
+    BOOST_TEST(container.get_ptr<square>(s)->side == 2.0);
+    BOOST_TEST(*container.get<std::string>(str) == "three");
+
+    // a key of another type is never found
+    BOOST_TEST(container.get_ptr<square>(c) == nullptr);
+    BOOST_TEST(!container.get<circle>(s));
+}
+
+BOOST_AUTO_TEST_CASE( visit_dispatches_on_the_type ) {
+    shapes container;
+    auto c = container.emplace<circle>(circle{1.0});
+    auto s = container.emplace<square>(square{2.0});
+
+    struct area {
+        double& result;
+        void operator()(circle const& x) const { result = 3 * x.radius; }
+        void operator()(square const& x) const { result = x.side * x.side; }
+        void operator()(std::string const&) const { result = -1; }
+    };
+
+    double result = 0;
+    BOOST_TEST(container.visit(c, area{result}));
+    BOOST_TEST(result == 3.0);
+    BOOST_TEST(std::as_const(container).visit(s, area{result}));
+    BOOST_TEST(result == 4.0);
+}
+
+BOOST_AUTO_TEST_CASE( removal_goes_to_the_right_pool ) {
+    shapes container;
+    auto c = container.emplace<circle>(circle{1.0});
+    auto s = container.emplace<square>(square{2.0});
+
+    container.remove(c);
+    BOOST_TEST(!container.is_present(c));
+    BOOST_TEST(container.is_present(s));
+
+    auto c2 = container.emplace<circle>(circle{5.0});
+    BOOST_TEST(!container.is_present(c));
+    BOOST_TEST(container.get<circle>(c2)->radius == 5.0);
+}
+
+BOOST_AUTO_TEST_CASE( iteration_is_per_type ) {
+    shapes container;
+    (void)container.emplace<circle>(circle{1.0});
+    (void)container.emplace<square>(square{2.0});
+    (void)container.emplace<circle>(circle{3.0});
+
+    double sum = 0;
+    for(auto const& x : container.pool<circle>()) {
+        sum += x.radius;
+    }
+    BOOST_TEST(sum == 4.0);
+
+    int count = 0;
+    container.for_each([&](auto const&) { ++count; });
+    BOOST_TEST(count == 3);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+
+static bool empty_init() {
+    return true;
+}
+
+int main(int argc, char* argv[], char* envp[]) {
+    (void)envp;
+    return ::boost::unit_test::unit_test_main( &empty_init, argc, argv );
+}
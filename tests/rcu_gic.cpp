@@ -0,0 +1,128 @@
+#ifndef BOOST_TEST_DYN_LINK
+#define BOOST_TEST_DYN_LINK
+#endif
+#include <boost/test/unit_test.hpp>
+#include <atomic>
+#include <iterator>
+#include <memory>
+#include <thread>
+#include <rcu_gic.hpp>
+#include <split_gic.hpp>
+using namespace boost::unit_test;
+
+using namespace genex;
+
+constexpr int
+    NON_ZERO_VAL_1 = 444,
+    NON_ZERO_VAL_2 = 5555;
+
+struct RcuFixture {
+    rcu_gic<split_gic<int>> container;
+};
+
+BOOST_AUTO_TEST_SUITE( rcu_gic_tests )
+
+BOOST_FIXTURE_TEST_CASE( writes_are_invisible_before_publish, RcuFixture ) {
+    auto key = container.writer().emplace(NON_ZERO_VAL_1);
+    auto snap = container.read();
+
+    BOOST_TEST(snap.get_ptr(key) == nullptr);
+    BOOST_TEST(snap.epoch() == 0u);
+    BOOST_TEST((snap.begin() == snap.end()));
+}
+
+BOOST_FIXTURE_TEST_CASE( publish_makes_writes_visible, RcuFixture ) {
+    auto key = container.writer().emplace(NON_ZERO_VAL_1);
+    BOOST_TEST(container.publish() == 1u);
+    auto snap = container.read();
+
+    BOOST_TEST(*snap[key] == NON_ZERO_VAL_1);
+    BOOST_TEST(*snap.begin() == NON_ZERO_VAL_1);
+    BOOST_TEST(snap.epoch() == 1u);
+}
+
+BOOST_FIXTURE_TEST_CASE( snapshot_outlives_publish, RcuFixture ) {
+    auto key = container.writer().emplace(NON_ZERO_VAL_1);
+    container.publish();
+    auto old_snap = container.read();
+
+    container.writer().remove(key);
+    auto new_key = container.writer().emplace(NON_ZERO_VAL_2);
+    container.publish();
+    auto new_snap = container.read();
+
+    BOOST_TEST(*old_snap.get(key) == NON_ZERO_VAL_1);
+    BOOST_TEST(!old_snap.is_present(new_key));
+    BOOST_TEST(!new_snap.is_present(key));
+    BOOST_TEST(*new_snap.get(new_key) == NON_ZERO_VAL_2);
+}
+
+BOOST_FIXTURE_TEST_CASE( publish_recycles_released_versions, RcuFixture ) {
+    auto removed = container.writer().emplace(NON_ZERO_VAL_1);
+    auto kept = container.writer().emplace(NON_ZERO_VAL_2);
+    container.publish();
+    auto const* first_state = std::addressof(*container.read());
+
+    container.writer().remove(removed);
+    container.publish();
+    auto held = container.read();
+
+    // the version of epoch 1 is brought up to date
+    auto added = container.writer().emplace(NON_ZERO_VAL_1);
+    *container.writer().get_ptr(kept) = 7;
+    container.publish();
+    auto snap = container.read();
+    BOOST_TEST(std::addressof(*snap) == first_state);
+    BOOST_TEST(!snap.is_present(removed));
+    BOOST_TEST(*snap[kept] == 7);
+    BOOST_TEST(*snap[added] == NON_ZERO_VAL_1);
+    BOOST_TEST(std::distance(snap.begin(), snap.end()) == 2);
+
+    // the version of epoch 2 is still held, hence copied instead
+    container.publish();
+    BOOST_TEST(std::addressof(*container.read()) != std::addressof(*held));
+    BOOST_TEST(*held[kept] == NON_ZERO_VAL_2);
+    BOOST_TEST(!held.is_present(added));
+}
+
+BOOST_FIXTURE_TEST_CASE( concurrent_readers, RcuFixture ) {
+    constexpr int ticks = 200;
+    std::atomic<bool> inconsistent{false};
+
+    std::thread reader([&] {
+        std::size_t last_epoch = 0;
+        while(last_epoch != ticks) {
+            auto snap = container.read();
+
+            // the writer publishes one more element per tick
+            std::size_t count = 0;
+            for(int v : snap) {
+                (void)v;
+                ++count;
+            }
+            if(count != snap.epoch() || snap.epoch() < last_epoch) {
+                inconsistent = true;
+            }
+            last_epoch = snap.epoch();
+        }
+    });
+
+    for(int i = 0; i < ticks; ++i) {
+        (void)container.writer().emplace(i);
+        container.publish();
+    }
+    reader.join();
+
+    BOOST_TEST(!inconsistent);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+static bool empty_init() {
+    return true;
+}
+
+int main(int argc, char* argv[], char* envp[]) {
+    (void)envp;
+    return ::boost::unit_test::unit_test_main( &empty_init, argc, argv );
+}
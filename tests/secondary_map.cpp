@@ -0,0 +1,154 @@
+#ifndef BOOST_TEST_DYN_LINK
+#define BOOST_TEST_DYN_LINK
+#endif
+#include <boost/test/unit_test.hpp>
+#include <memory>
+#include <utility>
+#include <secondary_map.hpp>
+#include <split_gic.hpp>
+#include "zero_on_destruction.hpp"
+using namespace boost::unit_test;
+
+using namespace genex;
+
+constexpr int
+    NON_ZERO_VAL = 444,
+    NON_ZERO_VAL_1 = NON_ZERO_VAL,
+    NON_ZERO_VAL_2 = 5555;
+
+struct SecondaryMapFixture {
+    using owner_type = split_gic<int>;
+    using key_type = owner_type::key_type;
+
+    owner_type owner;
+    secondary_map<key_type, double> side;
+};
+
+BOOST_AUTO_TEST_SUITE( secondary_map_tests )
+
+BOOST_FIXTURE_TEST_CASE( insert_get, SecondaryMapFixture ) {
+    auto key = owner.emplace(NON_ZERO_VAL);
+    double& inserted = side.insert(key, 0.5);
+
+    BOOST_TEST((side.get(key) != side.failed_get()));
+    BOOST_TEST(*side[key] == 0.5);
+    BOOST_TEST(std::addressof(inserted) == side.get_ptr(key));
+    BOOST_TEST(*std::as_const(side).get_ptr(key) == 0.5);
+}
+
+BOOST_FIXTURE_TEST_CASE( get_never_inserted, SecondaryMapFixture ) {
+    auto key_a = owner.emplace(NON_ZERO_VAL_1);
+    auto key_b = owner.emplace(NON_ZERO_VAL_2);
+    side.insert(key_b, 0.5);
+
+    BOOST_TEST((side.get(key_a) == side.failed_get()));
+    BOOST_TEST(!side.is_present(key_a));
+}
+
+BOOST_FIXTURE_TEST_CASE( grows_to_highest_index, SecondaryMapFixture ) {
+    key_type far_key{1000, 0};
+    side.insert(far_key, 0.5);
+
+    BOOST_TEST(*side[far_key] == 0.5);
+    BOOST_TEST((side.begin() != side.end()));
+    BOOST_TEST(*side.begin() == 0.5);
+}
+
+BOOST_FIXTURE_TEST_CASE( stale_key_is_rejected, SecondaryMapFixture ) {
+    auto old_key = owner.emplace(NON_ZERO_VAL_1);
+    side.insert(old_key, 0.5);
+    owner.remove(old_key);
+    auto new_key = owner.emplace(NON_ZERO_VAL_2);
+
+    BOOST_TEST(new_key.get_index() == old_key.get_index());
+    BOOST_TEST(side.get_ptr(new_key) == nullptr);
+
+    side.insert(new_key, 1.5);
+    BOOST_TEST(side.get_ptr(old_key) == nullptr);
+    BOOST_TEST(*side[new_key] == 1.5);
+}
+
+BOOST_FIXTURE_TEST_CASE( remove_get, SecondaryMapFixture ) {
+    auto key = owner.emplace(NON_ZERO_VAL);
+    side.insert(key, 0.5);
+    side.remove(key);
+
+    BOOST_TEST((side[key] == side.failed_get()));
+    BOOST_TEST((side.begin() == side.end()));
+}
+
+BOOST_FIXTURE_TEST_CASE( iteration_skips_empty_slots, SecondaryMapFixture ) {
+    auto key_a = owner.emplace(NON_ZERO_VAL);
+    auto key_b = owner.emplace(NON_ZERO_VAL);
+    auto key_c = owner.emplace(NON_ZERO_VAL);
+    side.insert(key_a, 0.5);
+    side.insert(key_c, 1.5);
+    (void)key_b;
+
+    auto it = std::as_const(side).begin();
+    BOOST_TEST(*it++ == 0.5);
+    BOOST_TEST(*it++ == 1.5);
+    BOOST_TEST((it == side.cend()));
+}
+
+BOOST_FIXTURE_TEST_CASE( end_decrements_to_the_last_value, SecondaryMapFixture ) {
+    // Three values leave unused slots after the last one.
+    auto key_a = owner.emplace(NON_ZERO_VAL);
+    auto key_b = owner.emplace(NON_ZERO_VAL);
+    auto key_c = owner.emplace(NON_ZERO_VAL);
+    side.insert(key_a, 0.5);
+    side.insert(key_b, 1.5);
+    side.insert(key_c, 2.5);
+
+    auto it = side.end();
+    BOOST_TEST(*--it == 2.5);
+    BOOST_TEST(*--it == 1.5);
+    BOOST_TEST(*--it == 0.5);
+    BOOST_TEST((it == side.begin()));
+}
+
+BOOST_FIXTURE_TEST_CASE( copy_is_independent, SecondaryMapFixture ) {
+    auto key = owner.emplace(NON_ZERO_VAL);
+    side.insert(key, 0.5);
+    auto copy = side;
+    *copy[key] = 1.5;
+
+    BOOST_TEST(*side[key] == 0.5);
+    BOOST_TEST(*copy[key] == 1.5);
+}
+
+BOOST_AUTO_TEST_CASE( destruction ) {
+    using owner_type = split_gic<int>;
+    int on_removal = NON_ZERO_VAL;
+    int on_overwrite = NON_ZERO_VAL;
+    int on_raii = NON_ZERO_VAL;
+
+    owner_type owner;
+    auto key_a = owner.emplace(NON_ZERO_VAL);
+    auto key_b = owner.emplace(NON_ZERO_VAL);
+
+    {
+        secondary_map<owner_type::key_type, zero_on_destruction<int>> side;
+        side.insert(key_a, on_removal);
+        side.remove(key_a);
+        BOOST_TEST(on_removal == 0);
+
+        side.insert(key_b, on_overwrite);
+        side.insert(key_b, on_raii);
+        BOOST_TEST(on_overwrite == 0);
+        BOOST_TEST(on_raii == NON_ZERO_VAL);
+    }
+
+    BOOST_TEST(on_raii == 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+static bool empty_init() {
+    return true;
+}
+
+int main(int argc, char* argv[], char* envp[]) {
+    (void)envp;
+    return ::boost::unit_test::unit_test_main( &empty_init, argc, argv );
+}
@@ -0,0 +1,122 @@
+#ifndef BOOST_TEST_DYN_LINK
+#define BOOST_TEST_DYN_LINK
+#endif
+#include <boost/test/unit_test.hpp>
+#include <algorithm>
+#include <thread>
+#include <vector>
+#include <split_gic.hpp>
+#include <sharded_gic.hpp>
+using namespace boost::unit_test;
+
+using namespace genex;
+
+using sharded = sharded_gic<split_gic<int>, 4>;
+
+BOOST_AUTO_TEST_SUITE( sharded_gic_tests )
+
+BOOST_AUTO_TEST_CASE( keys_are_routed_to_their_shard ) {
+    sharded container;
+    auto k0 = container.shard(0).emplace(10);
+    auto k2 = container.shard(2).emplace(12);
+    auto k2bis = container.shard(2).emplace(22);
+
+    BOOST_TEST(sharded::shard_of(k0) == 0u);
+    BOOST_TEST(sharded::shard_of(k2) == 2u);
+    BOOST_TEST(sharded::shard_of(k2bis) == 2u);
+    BOOST_TEST((k0 != k2 && k2 != k2bis));
+
+    BOOST_TEST(*container[k0] == 10);
+    BOOST_TEST(*container[k2] == 12);
+    BOOST_TEST(*container.get_ptr(k2bis) == 22);
+    BOOST_TEST(container.shard(2).is_present(k2));
+    BOOST_TEST(!container.shard(1).is_present(k2));
+}
+
+BOOST_AUTO_TEST_CASE( removal_only_affects_its_shard ) {
+    sharded container;
+    auto k1 = container.shard(1).emplace(1);
+    auto k3 = container.shard(3).emplace(3);
+
+    // k3 has the same local key in shard 3 as k1 in shard 1
+    container.shard(1).remove(k3);
+    BOOST_TEST(container.is_present(k1));
+    BOOST_TEST(container.is_present(k3));
+
+    container.shard(1).remove(k1);
+    BOOST_TEST(!container.is_present(k1));
+    BOOST_TEST(container.is_present(k3));
+
+    // the freed local slot is reused with a newer generation
+    auto k1bis = container.shard(1).emplace(11);
+    BOOST_TEST(!container.is_present(k1));
+    BOOST_TEST(*container[k1bis] == 11);
+
+    container.remove(k3);
+    BOOST_TEST(!container.get(k3));
+}
+
+BOOST_AUTO_TEST_CASE( iteration_visits_every_shard ) {
+    sharded container;
+    BOOST_TEST((container.begin() == container.end()));
+
+    // shards 0 and 2 stay empty
+    (void)container.shard(1).emplace(1);
+    (void)container.shard(3).emplace(3);
+    (void)container.shard(3).emplace(4);
+
+    std::vector<int> values(container.cbegin(), container.cend());
+    std::sort(values.begin(), values.end());
+    BOOST_TEST(values == (std::vector<int>{1, 3, 4}));
+
+    for(auto& value : container) {
+        value *= 2;
+    }
+    sharded const& const_container = container;
+    BOOST_TEST(std::count(const_container.begin(),
+                          const_container.end(),
+                          8) == 1);
+}
+
+BOOST_AUTO_TEST_CASE( shards_are_filled_concurrently ) {
+    constexpr int per_thread = 1000;
+    sharded container;
+    std::vector<std::vector<sharded::key_type>> keys(
+                sharded::shard_count());
+
+    std::vector<std::thread> workers;
+    for(std::size_t id = 0; id < sharded::shard_count(); ++id) {
+        workers.emplace_back([&, id] {
+            auto shard = container.shard(id);
+            for(int i = 0; i < per_thread; ++i) {
+                keys[id].push_back(shard.emplace(i));
+            }
+            for(int i = 0; i < per_thread; i += 2) {
+                shard.remove(keys[id][i]);
+            }
+        });
+    }
+    for(auto& worker : workers) {
+        worker.join();
+    }
+
+    for(auto const& shard_keys : keys) {
+        for(int i = 0; i < per_thread; ++i) {
+            BOOST_TEST(container.is_present(shard_keys[i]) == (i % 2 == 1));
+        }
+    }
+    BOOST_TEST(std::distance(container.begin(), container.end()) ==
+               per_thread / 2 * 4);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+
+static bool empty_init() {
+    return true;
+}
+
+int main(int argc, char* argv[], char* envp[]) {
+    (void)envp;
+    return ::boost::unit_test::unit_test_main( &empty_init, argc, argv );
+}
@@ -0,0 +1,127 @@
+#ifndef BOOST_TEST_DYN_LINK
+#define BOOST_TEST_DYN_LINK
+#endif
+#include <boost/test/unit_test.hpp>
+#include <map>
+#include <memory>
+#include <utility>
+#include <vector>
+#include <sparse_secondary_map.hpp>
+#include <split_gic.hpp>
+using namespace boost::unit_test;
+
+using namespace genex;
+
+constexpr int
+    NON_ZERO_VAL = 444,
+    NON_ZERO_VAL_1 = NON_ZERO_VAL,
+    NON_ZERO_VAL_2 = 5555;
+
+struct SparseSecondaryMapFixture {
+    using owner_type = split_gic<int>;
+    using key_type = owner_type::key_type;
+
+    owner_type owner;
+    sparse_secondary_map<key_type, double> side;
+};
+
+BOOST_AUTO_TEST_SUITE( sparse_secondary_map_tests )
+
+BOOST_FIXTURE_TEST_CASE( empty_get, SparseSecondaryMapFixture ) {
+    auto key = owner.emplace(NON_ZERO_VAL);
+
+    BOOST_TEST((side.get(key) == side.failed_get()));
+    BOOST_TEST(side.empty());
+    BOOST_TEST((side.begin() == side.end()));
+}
+
+BOOST_FIXTURE_TEST_CASE( insert_get, SparseSecondaryMapFixture ) {
+    auto key = owner.emplace(NON_ZERO_VAL);
+    double& inserted = side.insert(key, 0.5);
+
+    BOOST_TEST(*side[key] == 0.5);
+    BOOST_TEST(std::addressof(inserted) == side.get_ptr(key));
+    BOOST_TEST(*std::as_const(side).get_ptr(key) == 0.5);
+    BOOST_TEST(side.size() == 1u);
+}
+
+BOOST_FIXTURE_TEST_CASE( stale_key_is_rejected, SparseSecondaryMapFixture ) {
+    auto old_key = owner.emplace(NON_ZERO_VAL_1);
+    side.insert(old_key, 0.5);
+    owner.remove(old_key);
+    auto new_key = owner.emplace(NON_ZERO_VAL_2);
+
+    BOOST_TEST(side.get_ptr(new_key) == nullptr);
+    side.remove(new_key);
+    BOOST_TEST(side.size() == 1u);
+
+    side.insert(new_key, 1.5);
+    BOOST_TEST(side.get_ptr(old_key) == nullptr);
+    BOOST_TEST(*side[new_key] == 1.5);
+    BOOST_TEST(side.size() == 1u);
+}
+
+BOOST_FIXTURE_TEST_CASE( remove_get, SparseSecondaryMapFixture ) {
+    auto key_a = owner.emplace(NON_ZERO_VAL);
+    auto key_b = owner.emplace(NON_ZERO_VAL);
+    side.insert(key_a, 0.5);
+    side.insert(key_b, 1.5);
+    side.remove(key_a);
+
+    BOOST_TEST((side[key_a] == side.failed_get()));
+    BOOST_TEST(*side[key_b] == 1.5);
+    BOOST_TEST(*side.begin() == 1.5);
+    BOOST_TEST((side.present_keys().front() == key_b));
+}
+
+BOOST_FIXTURE_TEST_CASE( matches_a_map, SparseSecondaryMapFixture ) {
+    std::vector<key_type> keys;
+    std::map<std::size_t, double> expected;
+
+    for(int i = 0; i < 1000; ++i) {
+        keys.push_back(owner.emplace(i));
+    }
+
+    // inserts one key out of three, then removes one out of two
+    for(std::size_t i = 0; i < keys.size(); i += 3) {
+        side.insert(keys[i], static_cast<double>(i));
+        expected[i] = static_cast<double>(i);
+    }
+    for(std::size_t i = 0; i < keys.size(); i += 2) {
+        side.remove(keys[i]);
+        expected.erase(i);
+    }
+
+    BOOST_TEST(side.size() == expected.size());
+    for(std::size_t i = 0; i < keys.size(); ++i) {
+        auto it = expected.find(i);
+        double const* found = side.get_ptr(keys[i]);
+        if(it == expected.end()) {
+            BOOST_TEST(found == nullptr);
+        }
+        else {
+            BOOST_TEST((found != nullptr && *found == it->second));
+        }
+    }
+
+    double sum = 0;
+    for(double v : std::as_const(side)) {
+        sum += v;
+    }
+    double expected_sum = 0;
+    for(auto const& [i, v] : expected) {
+        expected_sum += v;
+    }
+    BOOST_TEST(sum == expected_sum);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+static bool empty_init() {
+    return true;
+}
+
+int main(int argc, char* argv[], char* envp[]) {
+    (void)envp;
+    return ::boost::unit_test::unit_test_main( &empty_init, argc, argv );
+}
@@ -2,6 +2,11 @@
 #define BOOST_TEST_DYN_LINK
 #endif
 #include <boost/test/unit_test.hpp>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
 #include <split_gic.hpp>
 using namespace boost::unit_test;
 
@@ -16,6 +21,356 @@ BOOST_AUTO_TEST_SUITE( split_gic_tests )
 #include "generic/gic_base_tests.hpp"
 #include "generic/gic_iterator_tests.hpp"
 
+BOOST_AUTO_TEST_CASE( trim_drops_trailing_free_slots ) {
+    split_gic<int> container;
+    std::vector<key<int>> keys;
+    for(int i = 0; i < 10; ++i) {
+        keys.push_back(container.emplace(i));
+    }
+    for(int i : {9, 3, 7, 8, 6}) {
+        container.remove(keys[i]);
+    }
+
+    container.trim();
+    auto usage = container.memory_usage();
+    BOOST_TEST(usage.live_slots == 5u);
+    BOOST_TEST(usage.free_slots == 1u);
+    BOOST_TEST(usage.free_indexes.used_bytes == sizeof(std::size_t));
+
+    // the free slot in the middle is reused first, then slots are appended
+    auto in_middle = container.emplace(30);
+    BOOST_TEST(in_middle.get_index() == 3u);
+    for(int i = 6; i < 10; ++i) {
+        auto k = container.emplace(i * 10);
+        BOOST_TEST(k.get_index() == keys[i].get_index());
+        BOOST_TEST(!container.is_present(keys[i]));
+        BOOST_TEST(*container[k] == i * 10);
+    }
+}
+
+BOOST_AUTO_TEST_CASE( trim_of_empty_container ) {
+    split_gic<int> container;
+    auto k = container.emplace(1);
+    container.remove(k);
+
+    container.trim();
+    BOOST_TEST(container.memory_usage().objects.used_bytes == 0u);
+    BOOST_TEST((container.begin() == container.end()));
+
+    auto k2 = container.emplace(2);
+    BOOST_TEST(!container.is_present(k));
+    BOOST_TEST(*container[k2] == 2);
+}
+
+BOOST_AUTO_TEST_CASE( shrink_to_fit_releases_memory ) {
+    split_gic<std::string> container;
+    std::vector<key<std::string>> keys;
+    for(int i = 0; i < 100; ++i) {
+        keys.push_back(container.emplace(std::string(32, 'a') +
+                                         std::to_string(i)));
+    }
+    for(int i = 10; i < 100; ++i) {
+        container.remove(keys[i]);
+    }
+
+    container.shrink_to_fit();
+    auto usage = container.memory_usage();
+    BOOST_TEST(usage.allocated_bytes() == usage.used_bytes());
+    BOOST_TEST(usage.live_slots == 10u);
+    for(int i = 0; i < 10; ++i) {
+        BOOST_TEST(*container[keys[i]] ==
+                   std::string(32, 'a') + std::to_string(i));
+    }
+}
+
+BOOST_AUTO_TEST_CASE( reserved_keys_are_constructed_concurrently ) {
+    constexpr std::size_t count = 10000;
+    constexpr std::size_t workers = 4;
+
+    split_gic<std::string> container;
+    auto before = container.emplace("before");
+    auto reservation = container.reserve_keys(count);
+    BOOST_TEST(reservation.size() == count);
+
+    std::vector<std::thread> threads;
+    for(std::size_t w = 0; w < workers; ++w) {
+        threads.emplace_back([&reservation, w] {
+            for(std::size_t i = w; i < count; i += workers) {
+                reservation.construct(i, std::to_string(i));
+            }
+        });
+    }
+    for(auto& thread : threads) {
+        thread.join();
+    }
+
+    // nothing is visible before the commit
+    BOOST_TEST(!container.is_present(reservation.key(0)));
+    BOOST_TEST(std::distance(container.begin(), container.end()) == 1);
+
+    container.commit(reservation);
+    BOOST_TEST(*container[before] == "before");
+    for(std::size_t i = 0; i < count; ++i) {
+        BOOST_TEST(*container[reservation.key(i)] == std::to_string(i));
+    }
+    BOOST_TEST(std::distance(container.begin(), container.end()) ==
+               static_cast<std::ptrdiff_t>(count + 1));
+}
+
+BOOST_AUTO_TEST_CASE( uncommitted_reservation_destroys_its_objects ) {
+    auto const shared = std::make_shared<int>(0);
+
+    split_gic<std::shared_ptr<int>> container;
+    auto before = container.emplace(shared);
+    {
+        auto reservation = container.reserve_keys(4);
+        reservation.construct(0, shared);
+        reservation.construct(2, shared);
+        BOOST_TEST(shared.use_count() == 4);
+    }
+
+    BOOST_TEST(shared.use_count() == 2);
+    BOOST_TEST(container.memory_usage().live_slots == 1u);
+    BOOST_TEST(container.memory_usage().free_slots == 0u);
+
+    auto reservation = container.reserve_keys(2);
+    reservation.construct(1, shared);
+    reservation.cancel();
+    reservation.cancel();
+    BOOST_TEST(shared.use_count() == 2);
+
+    // the reserved keys never become valid
+    auto after = container.emplace(shared);
+    BOOST_TEST(!container.is_present(reservation.key(0)));
+    BOOST_TEST(*container[before] == shared);
+    BOOST_TEST(*container[after] == shared);
+}
+
+BOOST_AUTO_TEST_CASE( reservation_survives_a_throwing_worker ) {
+    split_gic<std::string> container;
+    auto const fill = [&container] {
+        auto reservation = container.reserve_keys(3);
+        reservation.construct(0, std::string(32, 'a'));
+        throw std::runtime_error("worker failed");
+    };
+
+    BOOST_CHECK_THROW(fill(), std::runtime_error);
+    BOOST_TEST(container.memory_usage().free_slots == 0u);
+    BOOST_TEST((container.begin() == container.end()));
+}
+
+BOOST_AUTO_TEST_CASE( splice_fills_free_slots_then_appends ) {
+    split_gic<std::string> container;
+    auto a = container.emplace("a");
+    auto b = container.emplace("b");
+    container.remove(a);
+
+    split_gic<std::string> other;
+    std::vector<key<std::string>> old_keys;
+    for(int i = 0; i < 5; ++i) {
+        old_keys.push_back(other.emplace(std::to_string(i)));
+    }
+    other.remove(old_keys[2]);
+
+    auto mapping = container.splice(other);
+    BOOST_TEST(std::distance(other.begin(), other.end()) == 0);
+    BOOST_TEST(std::distance(mapping.begin(), mapping.end()) == 4);
+    BOOST_TEST(!mapping.is_present(old_keys[2]));
+    BOOST_TEST(*container[b] == "b");
+
+    // the first element took the free slot of a, the others were appended
+    BOOST_TEST(mapping[old_keys[0]]->get_index() == a.get_index());
+    BOOST_TEST(!container.is_present(a));
+    for(int i : {0, 1, 3, 4}) {
+        BOOST_TEST(*container[*mapping[old_keys[i]]] == std::to_string(i));
+    }
+    BOOST_TEST(std::distance(container.begin(), container.end()) == 5);
+
+    // the old keys are not valid anymore in other
+    auto reused = other.emplace("new");
+    BOOST_TEST(!other.is_present(old_keys[0]));
+    BOOST_TEST(*other[reused] == "new");
+}
+
+BOOST_AUTO_TEST_CASE( splice_copies_runs_of_trivial_objects ) {
+    split_gic<int> container;
+    (void)container.emplace(-1);
+
+    split_gic<int> other;
+    std::vector<key<int>> old_keys;
+    for(int i = 0; i < 100; ++i) {
+        old_keys.push_back(other.emplace(i));
+    }
+    for(int i = 0; i < 100; i += 7) {
+        other.remove(old_keys[i]);
+    }
+
+    auto mapping = container.splice(other);
+    BOOST_TEST(std::distance(other.begin(), other.end()) == 0);
+    for(int i = 0; i < 100; ++i) {
+        if(i % 7 == 0) {
+            BOOST_TEST(!mapping.is_present(old_keys[i]));
+        }
+        else {
+            BOOST_TEST(*container[*mapping[old_keys[i]]] == i);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE( merge_leaves_the_other_container_untouched ) {
+    split_gic<std::string> container;
+    (void)container.emplace("mine");
+
+    split_gic<std::string> other;
+    auto k = other.emplace("theirs");
+
+    auto mapping = container.merge(other);
+    BOOST_TEST(*other[k] == "theirs");
+    BOOST_TEST(*container[*mapping[k]] == "theirs");
+    BOOST_TEST(std::distance(container.begin(), container.end()) == 2);
+}
+
+// copying it throws if it was made to
+struct copy_bomb {
+    std::string value;
+    bool armed = false;
+
+    copy_bomb(std::string value, bool armed)
+        : value(std::move(value)), armed(armed) {}
+
+    copy_bomb(copy_bomb const& other)
+        : value(other.value), armed(other.armed)
+    {
+        if(armed) {
+            throw std::runtime_error("copy_bomb");
+        }
+    }
+};
+
+BOOST_AUTO_TEST_CASE( throwing_merge_keeps_the_container_consistent ) {
+    split_gic<copy_bomb> container;
+    auto a = container.emplace(std::string(32, 'a'), false);
+    auto b = container.emplace("b", false);
+    container.remove(a);
+
+    // into the free slot
+    split_gic<copy_bomb> other;
+    (void)other.emplace("armed", true);
+    BOOST_CHECK_THROW((void)container.merge(other), std::runtime_error);
+    BOOST_TEST(container.memory_usage().free_slots == 1u);
+    auto c = container.emplace("c", false);
+    BOOST_TEST(c.get_index() == a.get_index());
+
+    // at the back
+    split_gic<copy_bomb> more;
+    (void)more.emplace(std::string(32, 'd'), false);
+    (void)more.emplace("armed", true);
+    BOOST_CHECK_THROW((void)container.merge(more), std::runtime_error);
+    BOOST_TEST(container.memory_usage().live_slots == 3u);
+    BOOST_TEST(container.memory_usage().free_slots == 0u);
+    BOOST_TEST(std::distance(container.begin(), container.end()) == 3);
+    BOOST_TEST(container[b]->value == "b");
+}
+
+BOOST_AUTO_TEST_CASE( for_each_run_yields_maximal_runs ) {
+    split_gic<int> container;
+    std::vector<key<int>> keys;
+    for(int i = 0; i < 10; ++i) {
+        keys.push_back(container.emplace(i));
+    }
+    for(int i : {0, 3, 4, 8}) {
+        container.remove(keys[i]);
+    }
+
+    std::vector<std::vector<int>> runs;
+    container.for_each_run([&](element_run<int> run) {
+        for(auto& x : run) {
+            x *= 10;
+        }
+        runs.emplace_back(run.begin(), run.end());
+    });
+
+    std::vector<std::vector<int>> expected{{10, 20}, {50, 60, 70}, {90}};
+    BOOST_TEST((runs == expected));
+
+    std::size_t total = 0;
+    std::as_const(container).for_each_run([&](element_run<int const> run) {
+        total += run.size;
+    });
+    BOOST_TEST(total == 6u);
+}
+
+BOOST_AUTO_TEST_CASE( delta_brings_a_copy_up_to_date ) {
+    split_gic<std::string> leader;
+    std::vector<key<std::string>> keys;
+    for(int i = 0; i < 10; ++i) {
+        keys.push_back(leader.emplace(std::to_string(i)));
+    }
+    auto follower = leader.clone();
+    auto baseline = leader.clone();
+
+    leader.remove(keys[1]);
+    leader.remove(keys[2]);
+    auto replacing = leader.emplace("replacing");
+    *leader[keys[5]] = "five";
+    auto appended = leader.emplace("appended");
+    auto appended_too = leader.emplace("appended too");
+
+    auto delta = leader.delta_from(baseline);
+    BOOST_TEST(delta.destroyed.size() == 2u);
+    BOOST_TEST(delta.created.size() == 3u);
+    BOOST_TEST(delta.modified.size() == 1u);
+
+    follower.apply_delta(std::move(delta));
+    BOOST_TEST(!follower.is_present(keys[1]));
+    BOOST_TEST(!follower.is_present(keys[2]));
+    BOOST_TEST(*follower[replacing] == "replacing");
+    BOOST_TEST(*follower[keys[5]] == "five");
+    BOOST_TEST(*follower[appended] == "appended");
+    BOOST_TEST(*follower[appended_too] == "appended too");
+    BOOST_TEST(std::distance(follower.begin(), follower.end()) ==
+               std::distance(leader.begin(), leader.end()));
+
+    // nothing changed since
+    BOOST_TEST(leader.delta_from(follower).empty());
+
+    // reusing a free slot does not revive a destroyed key
+    auto x = follower.emplace("x");
+    BOOST_TEST(!follower.is_present(keys[1]));
+    BOOST_TEST(!follower.is_present(keys[2]));
+    BOOST_TEST(*follower[x] == "x");
+}
+
+BOOST_AUTO_TEST_CASE( delta_of_trimmed_container ) {
+    split_gic<int> leader;
+    std::vector<key<int>> keys;
+    for(int i = 0; i < 8; ++i) {
+        keys.push_back(leader.emplace(i));
+    }
+    auto follower = leader.clone();
+    auto baseline = leader.clone();
+
+    for(int i = 4; i < 8; ++i) {
+        leader.remove(keys[i]);
+    }
+    leader.trim();
+    *leader[keys[0]] = 42;
+
+    auto const delta = leader.delta_from(baseline);
+    BOOST_TEST(delta.destroyed.size() == 4u);
+    BOOST_TEST(delta.modified.size() == 1u);
+
+    follower.apply_delta(delta);
+    BOOST_TEST(*follower[keys[0]] == 42);
+    BOOST_TEST(follower.memory_usage().live_slots == 4u);
+    BOOST_TEST(follower.memory_usage().free_slots == 0u);
+
+    // keys of the trimmed slots stay invalid when they are appended again
+    auto k = follower.emplace(100);
+    BOOST_TEST(k.get_index() == 4u);
+    BOOST_TEST(!follower.is_present(keys[4]));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 
@@ -0,0 +1,156 @@
+#ifndef BOOST_TEST_DYN_LINK
+#define BOOST_TEST_DYN_LINK
+#endif
+#include <boost/test/unit_test.hpp>
+#include <string>
+#include <vector>
+#include <split_gic.hpp>
+using namespace boost::unit_test;
+
+using namespace genex;
+
+template<typename T>
+using gic_derived = split_gic<T, std::vector, key<T>, intrusive_free_list>;
+#define OUTER_GIC_TEST
+
+BOOST_AUTO_TEST_SUITE( split_gic_intrusive_tests )
+
+#include "generic/gic_base_tests.hpp"
+#include "generic/gic_iterator_tests.hpp"
+
+BOOST_AUTO_TEST_CASE( free_indexes_take_no_memory ) {
+    gic_derived<int> container;
+    std::vector<key<int>> keys;
+    for(int i = 0; i < 10; ++i) {
+        keys.push_back(container.emplace(i));
+    }
+    for(int i = 0; i < 10; i += 2) {
+        container.remove(keys[i]);
+    }
+
+    auto usage = container.memory_usage();
+    BOOST_TEST(usage.free_slots == 5u);
+    BOOST_TEST(usage.free_indexes.allocated_bytes == 0u);
+
+    // the most recently freed slot is reused first
+    auto k = container.emplace(42);
+    BOOST_TEST(k.get_index() == keys[8].get_index());
+    for(int i = 0; i < 4; ++i) {
+        (void)container.emplace(i);
+    }
+    BOOST_TEST(container.memory_usage().free_slots == 0u);
+    BOOST_TEST(container.emplace(10).get_index() == 10u);
+}
+
+BOOST_AUTO_TEST_CASE( trim_relinks_free_slots ) {
+    gic_derived<int> container;
+    std::vector<key<int>> keys;
+    for(int i = 0; i < 6; ++i) {
+        keys.push_back(container.emplace(i));
+    }
+    for(int i : {1, 4, 5}) {
+        container.remove(keys[i]);
+    }
+
+    container.trim();
+    BOOST_TEST(container.emplace(10).get_index() == 1u);
+    BOOST_TEST(container.emplace(11).get_index() == 4u);
+}
+
+BOOST_AUTO_TEST_CASE( copy_and_growth_keep_the_order_of_free_slots ) {
+    gic_derived<std::string> container;
+    std::vector<key<std::string>> keys;
+    for(int i = 0; i < 5; ++i) {
+        keys.push_back(container.emplace(std::to_string(i)));
+    }
+    container.remove(keys[0]);
+    container.remove(keys[2]);
+
+    auto copy = container;
+    BOOST_TEST(copy.emplace("a").get_index() == 2u);
+
+    // reallocating relocates the living objects only
+    container.shrink_to_fit();
+    BOOST_TEST(container.emplace("a").get_index() == 2u);
+    BOOST_TEST(container.emplace("b").get_index() == 0u);
+
+    gic_derived<int> trivial;
+    std::vector<key<int>> trivial_keys;
+    for(int i = 0; i < 4; ++i) {
+        trivial_keys.push_back(trivial.emplace(i));
+    }
+    trivial.remove(trivial_keys[0]);
+    trivial.remove(trivial_keys[2]);
+
+    auto trivial_copy = trivial;
+    BOOST_TEST(trivial_copy.emplace(10).get_index() == 2u);
+    BOOST_TEST(trivial_copy.emplace(11).get_index() == 0u);
+}
+
+BOOST_AUTO_TEST_CASE( splice_pops_the_intrusive_list ) {
+    gic_derived<int> container;
+    std::vector<key<int>> keys;
+    for(int i = 0; i < 4; ++i) {
+        keys.push_back(container.emplace(i));
+    }
+    container.remove(keys[0]);
+    container.remove(keys[2]);
+
+    gic_derived<int> other;
+    std::vector<key<int>> old_keys;
+    for(int i = 10; i < 14; ++i) {
+        old_keys.push_back(other.emplace(i));
+    }
+
+    auto mapping = container.splice(other);
+    BOOST_TEST(container.memory_usage().free_slots == 0u);
+    for(int i = 0; i < 4; ++i) {
+        BOOST_TEST(*container[*mapping[old_keys[i]]] == 10 + i);
+    }
+    BOOST_TEST(container.emplace(20).get_index() == 6u);
+}
+
+BOOST_AUTO_TEST_CASE( for_each_run_of_slots_bigger_than_objects ) {
+    gic_derived<char> container;
+    for(char c : {'a', 'b', 'c'}) {
+        (void)container.emplace(c);
+    }
+
+    std::string seen;
+    container.for_each_run([&](element_run<char> run) {
+        BOOST_TEST(run.size == 1u);
+        seen += *run.data;
+    });
+    BOOST_TEST(seen == "abc");
+}
+
+BOOST_AUTO_TEST_CASE( apply_delta_relinks_free_slots ) {
+    gic_derived<int> leader;
+    std::vector<key<int>> keys;
+    for(int i = 0; i < 6; ++i) {
+        keys.push_back(leader.emplace(i));
+    }
+    auto follower = leader;
+    auto baseline = leader;
+
+    leader.remove(keys[1]);
+    leader.remove(keys[3]);
+    follower.apply_delta(leader.delta_from(baseline));
+
+    // the rebuilt list gives the lowest free slot first, unlike the leader's
+    BOOST_TEST(follower.memory_usage().free_slots == 2u);
+    BOOST_TEST(follower.emplace(10).get_index() == 1u);
+    BOOST_TEST(follower.emplace(11).get_index() == 3u);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+
+static bool empty_init() {
+    return true;
+}
+
+int main(int argc, char* argv[], char* envp[]) {
+    (void)envp;
+    return ::boost::unit_test::unit_test_main( &empty_init, argc, argv );
+}
@@ -0,0 +1,70 @@
+#ifndef BOOST_TEST_DYN_LINK
+#define BOOST_TEST_DYN_LINK
+#endif
+#include <boost/test/unit_test.hpp>
+#include <stdexcept>
+#include <string>
+#include <static_gic.hpp>
+using namespace boost::unit_test;
+
+using namespace genex;
+
+// large enough for every generic test
+template<typename T>
+using gic_derived = static_gic<T, 128>;
+#define OUTER_GIC_TEST
+
+BOOST_AUTO_TEST_SUITE( static_gic_tests )
+
+#include "generic/gic_base_tests.hpp"
+#include "generic/gic_iterator_tests.hpp"
+
+BOOST_AUTO_TEST_CASE( emplacing_when_full_fails ) {
+    static_gic<std::string, 2> container;
+    auto k1 = container.emplace("a");
+    (void)container.emplace("b");
+
+    BOOST_TEST(container.full());
+    BOOST_CHECK_THROW((void)container.emplace("c"), std::length_error);
+    BOOST_TEST(!container.try_emplace("c").has_value());
+    BOOST_TEST(container.size() == 2u);
+
+    container.remove(k1);
+    BOOST_TEST(!container.full());
+
+    auto k3 = container.try_emplace("c");
+    BOOST_TEST(k3.has_value());
+    BOOST_TEST(*container[*k3] == "c");
+    BOOST_TEST(!container.is_present(k1));
+}
+
+BOOST_AUTO_TEST_CASE( storage_is_inline ) {
+    static_assert(sizeof(static_gic<int, 16>) >= 16 * sizeof(int));
+    static_assert(static_gic<int, 16>::capacity() == 16);
+}
+
+constexpr int sum_of_remaining() {
+    static_gic<int, 4> container;
+    auto k1 = container.emplace(1);
+    auto k2 = container.emplace(2);
+    container.remove(k1);
+    auto k3 = container.emplace(3);
+    return *container.get_ptr(k2) + container.get_unchecked(k3) +
+           (container.get_ptr(k1) == nullptr ? 0 : 100);
+}
+
+BOOST_AUTO_TEST_CASE( usable_in_constant_expressions ) {
+    static_assert(sum_of_remaining() == 5);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+
+static bool empty_init() {
+    return true;
+}
+
+int main(int argc, char* argv[], char* envp[]) {
+    (void)envp;
+    return ::boost::unit_test::unit_test_main( &empty_init, argc, argv );
+}
@@ -0,0 +1,129 @@
+#ifndef BOOST_TEST_DYN_LINK
+#define BOOST_TEST_DYN_LINK
+#endif
+#include <boost/test/unit_test.hpp>
+#include <utility>
+#include <vector>
+#include <split_gic.hpp>
+#include <gic_fit.hpp>
+#include <statistics.hpp>
+using namespace boost::unit_test;
+
+using namespace genex;
+
+using counted_split_gic = split_gic<
+    int,
+    std::vector,
+    key<int>,
+    std::vector<std::size_t>,
+    std::vector<std::size_t>,
+    counting_statistics>;
+
+using counted_gic_fit = gic_fit<
+    int,
+    std::vector,
+    key<int>,
+    std::vector<std::size_t>,
+    std::variant,
+    counting_statistics>;
+
+BOOST_AUTO_TEST_SUITE( statistics_tests )
+
+BOOST_AUTO_TEST_CASE( disabled_statistics_take_no_space ) {
+    // the vectors, the generation of appended slots and the count of
+    // outstanding key reservations
+    static_assert(sizeof(split_gic<int>) ==
+                  sizeof(std::vector<int>) * 3 + sizeof(std::size_t) * 2);
+}
+
+BOOST_AUTO_TEST_CASE( disabled_statistics_are_zero ) {
+    split_gic<int> container;
+    auto k = container.emplace(1);
+    (void)container.get(k);
+
+    BOOST_TEST(container.statistics().successful_gets == 0u);
+}
+
+template<typename Gic>
+void check_counters() {
+    Gic container;
+    auto a = container.emplace(1);
+    auto b = container.emplace(2);
+    (void)container.emplace(3);
+
+    container.remove(b);
+    container.remove(b);
+    (void)container.get(a);
+    (void)container.get(b);
+    (void)std::as_const(container).get(a);
+
+    for(auto& v : container) {
+        (void)v;
+    }
+
+    (void)container.emplace(4);
+
+    gic_statistics const s = container.statistics();
+    BOOST_TEST(s.successful_gets == 2u);
+    BOOST_TEST(s.failed_gets == 1u);
+    BOOST_TEST(s.emplacements_at_back == 3u);
+    BOOST_TEST(s.emplacements_in_free_slots == 1u);
+    BOOST_TEST(s.reallocations >= 1u);
+    BOOST_TEST(s.reallocations <= 3u);
+    BOOST_TEST(s.removals == 1u);
+    BOOST_TEST(s.failed_removals == 1u);
+    BOOST_TEST(s.skipped_free_slots == 1u);
+
+    container.reset_statistics();
+    BOOST_TEST(container.statistics().successful_gets == 0u);
+}
+
+BOOST_AUTO_TEST_CASE( split_gic_counters ) {
+    check_counters<counted_split_gic>();
+}
+
+BOOST_AUTO_TEST_CASE( gic_fit_counters ) {
+    check_counters<counted_gic_fit>();
+}
+
+BOOST_AUTO_TEST_CASE( statistics_stay_with_their_container ) {
+    counted_split_gic counted;
+    auto k = counted.emplace(1);
+    (void)counted.get(k);
+    counted_split_gic other;
+
+    swap(counted, other);
+    BOOST_TEST(counted.statistics().successful_gets == 1u);
+    BOOST_TEST(other.statistics().successful_gets == 0u);
+    BOOST_TEST(*other.get(k) == 1);
+
+    counted = std::move(other);
+    BOOST_TEST(counted.statistics().successful_gets == 1u);
+    BOOST_TEST(counted.statistics().emplacements_at_back == 1u);
+}
+
+BOOST_AUTO_TEST_CASE( merge_counts_a_single_reallocation ) {
+    counted_split_gic container;
+    (void)container.emplace(0);
+
+    counted_split_gic other;
+    for(int i = 1; i < 6; ++i) {
+        (void)other.emplace(i);
+    }
+
+    container.reset_statistics();
+    (void)container.merge(other);
+    BOOST_TEST(container.statistics().emplacements_at_back == 5u);
+    BOOST_TEST(container.statistics().reallocations == 1u);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+static bool empty_init() {
+    return true;
+}
+
+int main(int argc, char* argv[], char* envp[]) {
+    (void)envp;
+    return ::boost::unit_test::unit_test_main( &empty_init, argc, argv );
+}
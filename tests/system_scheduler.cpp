@@ -0,0 +1,142 @@
+#ifndef BOOST_TEST_DYN_LINK
+#define BOOST_TEST_DYN_LINK
+#endif
+#include <boost/test/unit_test.hpp>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+#include <split_gic.hpp>
+#include <system_scheduler.hpp>
+using namespace boost::unit_test;
+
+using namespace genex;
+
+BOOST_AUTO_TEST_SUITE( system_scheduler_tests )
+
+BOOST_AUTO_TEST_CASE( conflicting_systems_run_in_order ) {
+    split_gic<int> values;
+    std::vector<key<int>> keys;
+    for(int i = 0; i < 1000; ++i) {
+        keys.push_back(values.emplace(i));
+    }
+    for(int i = 0; i < 1000; i += 3) {
+        values.remove(keys[i]);
+    }
+
+    long sum = 0;
+    system_scheduler scheduler(4);
+    scheduler.add_partitioned_system(values, [](auto const&, int& x) {
+        x += 1;
+    });
+    scheduler.add_system([&] {
+        sum = 0;
+        for(int x : values) {
+            sum += x;
+        }
+    }, reads(values));
+
+    long expected = 0;
+    for(int i = 0; i < 1000; ++i) {
+        if(i % 3 != 0) {
+            expected += i;
+        }
+    }
+
+    scheduler.run();
+    BOOST_TEST(sum == expected + 666);
+    scheduler.run();
+    BOOST_TEST(sum == expected + 2 * 666);
+}
+
+BOOST_AUTO_TEST_CASE( independent_systems_run_concurrently ) {
+    split_gic<int> a;
+    split_gic<int> b;
+
+    // systems conflicting through b: the second one starts after the first
+    // one ended, however long it takes
+    std::mutex mutex;
+    std::vector<int> events;
+    auto const log = [&](int event) {
+        std::lock_guard<std::mutex> lock(mutex);
+        events.push_back(event);
+    };
+
+    system_scheduler scheduler(2);
+    scheduler.add_system([&] {
+        log(1);
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        log(2);
+    }, reads(a), writes(b));
+    scheduler.add_system([&] { log(3); }, reads(b));
+    scheduler.run();
+    BOOST_TEST(events == (std::vector<int>{1, 2, 3}));
+
+    // independent systems: each one waits for the other one to start, long
+    // enough for a loaded machine, rather than forever
+    std::atomic<int> arrived{0};
+    std::atomic<bool> met{true};
+    auto const meet = [&] {
+        ++arrived;
+        auto const deadline = std::chrono::steady_clock::now() +
+                              std::chrono::seconds(10);
+        while(arrived.load() < 2) {
+            if(std::chrono::steady_clock::now() > deadline) {
+                met = false;
+                return;
+            }
+            std::this_thread::yield();
+        }
+    };
+
+    system_scheduler other_scheduler(2);
+    other_scheduler.add_system(meet, writes(a));
+    other_scheduler.add_system(meet, writes(b));
+    other_scheduler.run();
+    BOOST_TEST(met.load());
+}
+
+BOOST_AUTO_TEST_CASE( empty_partitioned_system_starts_its_dependents_once ) {
+    split_gic<int> empty;
+    int visited = 0;
+    int runs = 0;
+
+    system_scheduler scheduler(2);
+    scheduler.add_partitioned_system(empty, [&](auto const&, int&) {
+        ++visited;
+    });
+    scheduler.add_system([&] { ++runs; }, reads(empty));
+
+    scheduler.run();
+    BOOST_TEST(runs == 1);
+    scheduler.run();
+    BOOST_TEST(runs == 2);
+    BOOST_TEST(visited == 0);
+}
+
+BOOST_AUTO_TEST_CASE( exceptions_skip_the_remaining_systems ) {
+    split_gic<int> values;
+    bool ran = false;
+
+    system_scheduler scheduler(2);
+    scheduler.add_system([] { throw std::runtime_error("failed"); },
+                         writes(values));
+    scheduler.add_system([&] { ran = true; }, reads(values));
+
+    BOOST_CHECK_THROW(scheduler.run(), std::runtime_error);
+    BOOST_TEST(!ran);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+
+static bool empty_init() {
+    return true;
+}
+
+int main(int argc, char* argv[], char* envp[]) {
+    (void)envp;
+    return ::boost::unit_test::unit_test_main( &empty_init, argc, argv );
+}